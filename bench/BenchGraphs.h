@@ -0,0 +1,100 @@
+/**
+ * @file BenchGraphs.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Seeded synthetic graphs shared by the benchmarks, so they need no data files
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef BENCH_GRAPHS_H_
+#define BENCH_GRAPHS_H_
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief the edges of a Chung-Lu random graph with n vertices, average degree
+ * about avg_deg, and expected degrees proportional to (i + 1)^(-skew / 10),
+ * so skew 0 gives an Erdos-Renyi-like graph and larger skews give hubs
+ * @details The endpoints of each edge are drawn independently by their
+ * weights, duplicates and self-loops are left to the graph loaders. A
+ * quarter of the edges close a triangle with a random neighbor, so the
+ * non-agreements are not all close to 1 as in a purely random graph.
+ *
+ * @param n number of vertices
+ * @param avg_deg the average degree
+ * @param skew ten times the exponent of the degree distribution
+ * @return std::vector<std::pair<unsigned long, unsigned long>>
+ */
+inline std::vector<std::pair<unsigned long, unsigned long>> bench_edges(unsigned long n,
+    unsigned long avg_deg, unsigned long skew)
+{
+    std::mt19937_64 rng(n * 1000003ul + avg_deg * 1009ul + skew);
+    std::vector<double> weights(n);
+    for(unsigned long i = 0ul; i < n; ++i)
+        weights[i] = std::pow(static_cast<double>(i + 1), -static_cast<double>(skew) / 10.0);
+    std::discrete_distribution<unsigned long> endpoint(weights.begin(), weights.end());
+    std::uniform_int_distribution<unsigned long> coin(0ul, 3ul);
+    unsigned long m = n * avg_deg / 2;
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    edges.reserve(m);
+    while (edges.size() < m) {
+        auto u = endpoint(rng);
+        if (!edges.empty() && coin(rng) == 0ul) {
+            // closing a triangle through the endpoint of a random earlier edge
+            auto &e = edges[std::uniform_int_distribution<unsigned long>(0ul, edges.size() - 1)(rng)];
+            edges.push_back(std::make_pair(e.first, endpoint(rng)));
+            edges.push_back(std::make_pair(e.second, edges.back().second));
+            continue;
+        }
+        edges.push_back(std::make_pair(u, endpoint(rng)));
+    }
+    return edges;
+}
+
+/**
+ * @brief writes edges as the text edge list read by Graph::load_from_file
+ *
+ * @param filename the output file
+ * @param n number of vertices
+ * @param edges the edges
+ */
+inline void write_bench_edge_list(std::string filename, unsigned long n,
+    const std::vector<std::pair<unsigned long, unsigned long>> &edges)
+{
+    std::ofstream out(filename);
+    out << n << " " << edges.size() << "\n";
+    for(auto &e: edges)
+        out << e.first << " " << e.second << "\n";
+}
+
+/**
+ * @brief the graph sizes, skews and thread counts the benchmarks run on:
+ * {n, average degree, skew, threads}
+ */
+inline void BenchGraphArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "deg", "skew", "threads"});
+    for(long n: {1l << 12, 1l << 15})
+        for(long skew: {0l, 8l})
+            for(long threads: {1l, 4l})
+                b->Args({n, 16l, skew, threads});
+}
+
+/**
+ * @brief as BenchGraphArgs for the single-threaded benchmarks
+ */
+inline void BenchGraphArgsSequential(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "deg", "skew"});
+    for(long n: {1l << 12, 1l << 15})
+        for(long skew: {0l, 8l})
+            b->Args({n, 16l, skew});
+}
+
+#endif // BENCH_GRAPHS_H_
@@ -0,0 +1,64 @@
+/**
+ * @file graph_bench.cpp
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Benchmarks of loading a graph and of computing non-agreements
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include "lib/Graph.h"
+#include "lib/GraphCSR.h"
+#include "bench/BenchGraphs.h"
+
+static void BM_LoadFromFile(benchmark::State& state) {
+    auto n = state.range(0);
+    auto edges = bench_edges(n, state.range(1), state.range(2));
+    auto filename = "/tmp/hcc_bench_" + std::to_string(n) + "_" + std::to_string(state.range(2)) + ".txt";
+    write_bench_edge_list(filename, n, edges);
+    for (auto _ : state) {
+        Graph g;
+        g.load_from_file(filename, state.range(3));
+        benchmark::DoNotOptimize(g.get_positive_m());
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size());
+    std::remove(filename.c_str());
+}
+
+static void BM_GraphCSRFromGraph(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    for (auto _ : state) {
+        GraphCSR csr(&g);
+        benchmark::DoNotOptimize(csr.get_positive_m());
+    }
+    state.SetItemsProcessed(state.iterations() * g.get_positive_m());
+}
+
+static void BM_NonAgreement(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    std::mt19937_64 rng(1ul);
+    std::vector<std::pair<unsigned long, unsigned long>> pairs;
+    for(unsigned long i = 0ul; i < 4096ul; ++i) {
+        auto &e = edges[rng() % edges.size()];
+        if (e.first != e.second)
+            pairs.push_back(e);
+    }
+    unsigned long i = 0ul;
+    for (auto _ : state) {
+        auto &e = pairs[i++ % pairs.size()];
+        benchmark::DoNotOptimize(g.non_agreement(e.first, e.second));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_LoadFromFile)->Apply(BenchGraphArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GraphCSRFromGraph)->Apply(BenchGraphArgsSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NonAgreement)->Apply(BenchGraphArgsSequential);
+
+BENCHMARK_MAIN();
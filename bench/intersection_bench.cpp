@@ -0,0 +1,78 @@
+/**
+ * @file intersection_bench.cpp
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Microbenchmark of the common-neighbor counting kernels against
+ * the std::set_intersection based counting previously used by non_agreement
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include "lib/Intersection.h"
+
+/**
+ * @brief two random sorted neighborhoods of the given sizes with about
+ * a quarter of the shorter one in common
+ */
+static void make_lists(unsigned long size_a, unsigned long size_b,
+    std::vector<vertex_id_t> &a, std::vector<vertex_id_t> &b)
+{
+    std::mt19937_64 rng(size_a * 1000003ul + size_b);
+    std::uniform_int_distribution<unsigned long> dist(0ul, 4 * (size_a + size_b));
+    std::set<vertex_id_t> sa, sb;
+    while (sa.size() < size_a)
+        sa.insert(dist(rng));
+    auto it = sa.begin();
+    for(unsigned long i = 0ul; i < std::min(size_a, size_b) / 4; ++i, ++it)
+        sb.insert(*it);
+    while (sb.size() < size_b)
+        sb.insert(dist(rng));
+    a.assign(sa.begin(), sa.end());
+    b.assign(sb.begin(), sb.end());
+}
+
+/**
+ * @brief the counting previously done in Graph::non_agreement
+ */
+static unsigned long set_intersection_count(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    std::vector<vertex_id_t> neigh_intersect((size_a > size_b) ? size_a : size_b);
+    auto it = std::set_intersection(a, a + size_a, b, b + size_b, neigh_intersect.begin());
+    neigh_intersect.resize(it - neigh_intersect.begin());
+    return neigh_intersect.size();
+}
+
+template<unsigned long (*Kernel)(const vertex_id_t *, unsigned long, const vertex_id_t *, unsigned long)>
+static void BM_Kernel(benchmark::State& state) {
+    std::vector<vertex_id_t> a, b;
+    make_lists(state.range(0), state.range(1), a, b);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Kernel(a.data(), a.size(), b.data(), b.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * (a.size() + b.size()));
+    state.SetLabel(intersection_kernel_name());
+}
+
+static void DegreePairs(benchmark::internal::Benchmark* b) {
+    // balanced, mildly skewed and hub-vs-leaf degree pairs
+    for(long size: {8l, 64l, 512l, 4096l})
+        b->Args({size, size});
+    b->Args({64l, 512l});
+    b->Args({16l, 4096l});
+    b->Args({4l, 65536l});
+}
+
+BENCHMARK_TEMPLATE(BM_Kernel, set_intersection_count)->Apply(DegreePairs);
+BENCHMARK_TEMPLATE(BM_Kernel, intersection_count)->Apply(DegreePairs);
+BENCHMARK_TEMPLATE(BM_Kernel, intersection_count_scalar)->Apply(DegreePairs);
+BENCHMARK_TEMPLATE(BM_Kernel, intersection_count_galloping)->Apply(DegreePairs);
+BENCHMARK_TEMPLATE(BM_Kernel, intersection_count_sse)->Apply(DegreePairs);
+BENCHMARK_TEMPLATE(BM_Kernel, intersection_count_avx2)->Apply(DegreePairs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+/**
+ * @file nao_bench.cpp
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Benchmarks of building the NAOs and of reading them for a query
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#include <benchmark/benchmark.h>
+#include "lib/Graph.h"
+#include "lib/GraphCSR.h"
+#include "lib/EdgeSupport.h"
+#include "lib/NAO.h"
+#include "lib/NAOArena.h"
+#include "bench/BenchGraphs.h"
+
+static void BM_NAOConstruction(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    GraphCSR csr(state.range(0), &edges);
+    for (auto _ : state) {
+        // one NAO object per vertex over a shared support table
+        EdgeSupport support(&csr, state.range(3));
+        for(unsigned long v = 0ul; v < csr.get_n(); ++v) {
+            NAO nao(v, &csr, &support);
+            benchmark::DoNotOptimize(nao.get_nao());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * csr.get_positive_m());
+}
+
+static void BM_NAOArenaBuild(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    GraphCSR csr(state.range(0), &edges);
+    for (auto _ : state) {
+        NAOArena arena(&csr, state.range(3));
+        benchmark::DoNotOptimize(arena.memory_bytes());
+    }
+    state.SetItemsProcessed(state.iterations() * csr.get_positive_m());
+}
+
+static void BM_NAOQuery(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    std::vector<NAO*> naos;
+    for(unsigned long v = 0ul; v < 256ul; ++v)
+        naos.push_back(new NAO(v, &g));
+    unsigned long i = 0ul;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(naos[i++ % naos.size()]->query(0.5));
+    }
+    state.SetItemsProcessed(state.iterations());
+    for(auto nao: naos)
+        delete nao;
+}
+
+static void BM_NAOIsHeavy(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    std::vector<NAO*> naos;
+    for(unsigned long v = 0ul; v < 256ul; ++v)
+        naos.push_back(new NAO(v, &g));
+    unsigned long i = 0ul;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(naos[i++ % naos.size()]->is_heavy(0.5));
+    }
+    state.SetItemsProcessed(state.iterations());
+    for(auto nao: naos)
+        delete nao;
+}
+
+static void BM_ArenaClassifyHeavy(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    GraphCSR csr(state.range(0), &edges);
+    NAOArena arena(&csr);
+    std::vector<unsigned char> heavy;
+    for (auto _ : state) {
+        arena.classify_heavy(0.5, &heavy);
+        benchmark::DoNotOptimize(heavy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * csr.get_n());
+}
+
+BENCHMARK(BM_NAOConstruction)->Apply(BenchGraphArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NAOArenaBuild)->Apply(BenchGraphArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NAOQuery)->Apply(BenchGraphArgsSequential);
+BENCHMARK(BM_NAOIsHeavy)->Apply(BenchGraphArgsSequential);
+BENCHMARK(BM_ArenaClassifyHeavy)->Apply(BenchGraphArgsSequential);
+
+BENCHMARK_MAIN();
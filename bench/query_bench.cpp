@@ -0,0 +1,81 @@
+/**
+ * @file query_bench.cpp
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Benchmarks of query(eps) of the naive and the index-based engines,
+ * and of the hierarchical sweep
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#include <benchmark/benchmark.h>
+#include "lib/Graph.h"
+#include "lib/NaiveCorrelationClustering.h"
+#include "lib/IndexBasedCorrelationClustering.h"
+#include "lib/HierarchicalCorrelationClustering.h"
+#include "lib/Stats.h"
+#include "bench/BenchGraphs.h"
+
+static void BM_NaiveQuery(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    NaiveCorrelationClustering engine(&g);
+    for (auto _ : state) {
+        auto assignment = engine.query(0.5);
+        benchmark::DoNotOptimize(assignment->data());
+        delete assignment;
+    }
+    state.SetItemsProcessed(state.iterations() * g.get_positive_m());
+}
+
+static void BM_IndexQuery(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    IndexBasedCorrelationClustering engine(&g, state.range(3));
+    double eps = state.range(4) / 100.0;
+    stats_reset();
+    for (auto _ : state) {
+        auto assignment = engine.query(eps);
+        benchmark::DoNotOptimize(assignment->data());
+        delete assignment;
+    }
+    state.SetItemsProcessed(state.iterations() * g.get_positive_m());
+    auto stats = stats_snapshot();
+    state.counters["scanned"] = benchmark::Counter(stats.counters[STAT_NAO_ENTRIES_SCANNED],
+        benchmark::Counter::kAvgIterations);
+    //< the NAO and edge-order entries read per query
+}
+
+static void IndexQueryArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "deg", "skew", "threads", "eps%"});
+    for(long n: {1l << 12, 1l << 15})
+        for(long skew: {0l, 8l})
+            for(long threads: {1l, 4l})
+                for(long eps: {10l, 50l, 90l})
+                    b->Args({n, 16l, skew, threads, eps});
+}
+
+static void BM_HierarchicalSweep(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    HierarchicalCorrelationClustering engine(&g, state.range(3));
+    std::vector<double> schedule;
+    for(unsigned long i = 1ul; i <= 16ul; ++i)
+        schedule.push_back(i / 16.0);
+    for (auto _ : state) {
+        auto assignments = engine.query(schedule);
+        for(auto assignment: *assignments)
+            delete assignment;
+        delete assignments;
+    }
+    state.SetItemsProcessed(state.iterations() * schedule.size());
+}
+
+BENCHMARK(BM_NaiveQuery)->Apply(BenchGraphArgsSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IndexQuery)->Apply(IndexQueryArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HierarchicalSweep)->Apply(BenchGraphArgs)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
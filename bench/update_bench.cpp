@@ -0,0 +1,78 @@
+/**
+ * @file update_bench.cpp
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Benchmarks of the dynamic updates of the index-based engine, one at
+ * a time and in batches
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include "lib/Graph.h"
+#include "lib/IndexBasedCorrelationClustering.h"
+#include "lib/UpdateLog.h"
+#include "bench/BenchGraphs.h"
+
+/**
+ * @brief pairs of vertices which are not positive edges of g, to add and remove again
+ */
+static std::vector<std::pair<unsigned long, unsigned long>> non_edges(Graph *g, unsigned long count) {
+    std::mt19937_64 rng(count);
+    std::vector<std::pair<unsigned long, unsigned long>> pairs;
+    while (pairs.size() < count) {
+        auto u = rng() % g->get_n(), v = rng() % g->get_n();
+        if (u != v && !g->is_in_neigh_plus(u, v))
+            pairs.push_back(std::make_pair(u, v));
+    }
+    return pairs;
+}
+
+static void BM_SingleEdgeUpdate(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    IndexBasedCorrelationClustering engine(&g, state.range(3));
+    auto pairs = non_edges(&g, 1024ul);
+    unsigned long i = 0ul;
+    for (auto _ : state) {
+        // adding and removing the same edge keeps the graph the same across iterations
+        auto &e = pairs[i++ % pairs.size()];
+        engine.add_edge(e.first, e.second);
+        engine.remove_edge(e.first, e.second);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+static void BM_BatchedUpdates(benchmark::State& state) {
+    auto edges = bench_edges(state.range(0), state.range(1), state.range(2));
+    Graph g;
+    g.load_from_edges(state.range(0), &edges);
+    IndexBasedCorrelationClustering engine(&g, state.range(3));
+    auto batch_size = static_cast<unsigned long>(state.range(4));
+    auto pairs = non_edges(&g, batch_size);
+    std::vector<Update> adds, removes;
+    for(auto &e: pairs) {
+        adds.push_back(Update{ADD_EDGE, e.first, e.second, 0.0});
+        removes.push_back(Update{REMOVE_EDGE, e.first, e.second, 0.0});
+    }
+    for (auto _ : state) {
+        engine.apply_batch(&adds);
+        engine.apply_batch(&removes);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * batch_size);
+}
+
+static void BatchArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "deg", "skew", "threads", "batch"});
+    for(long skew: {0l, 8l})
+        for(long threads: {1l, 4l})
+            for(long batch: {16l, 256l, 4096l})
+                b->Args({1l << 15, 16l, skew, threads, batch});
+}
+
+BENCHMARK(BM_SingleEdgeUpdate)->Apply(BenchGraphArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchedUpdates)->Apply(BatchArgs)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,134 @@
+#include "ClusteringCost.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <algorithm>
+
+/**
+ * @brief the cost from the positive edges across clusters and the sizes of
+ * the clusters of the present vertices; labels up to the number of vertex
+ * ids are counted in place, larger ones are renumbered densely first
+ *
+ * @param assignment the cluster of every vertex id
+ * @param is_present whether a vertex id is part of the graph, called as is_present(v)
+ * @param m the number of positive edges
+ * @param across the number of positive edges across clusters
+ * @return ClusteringCost
+ */
+template<typename P>
+static ClusteringCost cost_from_sizes(const std::vector<unsigned long> *assignment, P is_present,
+    unsigned long m, unsigned long across)
+{
+    auto n = assignment->size();
+    unsigned long max_label = 0ul, singletons = 0ul;
+    for(unsigned long v = 0ul; v < n; ++v) {
+        if (!is_present(v))
+            continue;
+        if ((*assignment)[v] == SINGLETON_CLUSTER)
+            singletons++;
+        else
+            max_label = std::max(max_label, (*assignment)[v]);
+    }
+    std::vector<unsigned long> labels;
+    if (max_label > n) {
+        for(unsigned long v = 0ul; v < n; ++v) {
+            if (is_present(v) && (*assignment)[v] != SINGLETON_CLUSTER)
+                labels.push_back((*assignment)[v]);
+        }
+        std::sort(labels.begin(), labels.end());
+        labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+    }
+    std::vector<unsigned long> sizes(labels.empty() ? std::min(max_label, n) + 1 : labels.size(), 0ul);
+    for(unsigned long v = 0ul; v < n; ++v) {
+        auto c = (*assignment)[v];
+        if (!is_present(v) || c == SINGLETON_CLUSTER)
+            continue;
+        if (!labels.empty())
+            c = std::lower_bound(labels.begin(), labels.end(), c) - labels.begin();
+        sizes[c]++;
+    }
+    ClusteringCost cost;
+    cost.positive_across = across;
+    cost.clusters = singletons;
+    unsigned long pairs_within = 0ul;
+    for(auto s: sizes) {
+        if (s > 0ul) {
+            cost.clusters++;
+            pairs_within += s * (s - 1) / 2;
+        }
+    }
+    cost.negative_within = pairs_within - (m - across);
+    return cost;
+}
+
+/**
+ * @brief counts, in parallel, the positive edges whose endpoints are in
+ * different clusters, each edge seen from both of its endpoints
+ *
+ * @param assignment the cluster of every vertex id
+ * @param neighbors the positive neighbors of a vertex as a [first, last) pair of pointers,
+ * called as neighbors(v)
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return unsigned long
+ */
+template<typename N>
+static unsigned long count_across(const std::vector<unsigned long> *assignment, N neighbors,
+    unsigned int num_threads)
+{
+    auto threads = resolve_num_threads(num_threads);
+    std::vector<unsigned long> across(threads, 0ul);
+    parallel_for_weighted_indexed(assignment->size(),
+        [&](unsigned long v) {
+            auto range = neighbors(v);
+            return (range.second - range.first) + 1.0;
+        },
+        [&](unsigned long v, unsigned int t) {
+            unsigned long local = 0ul;
+            auto c = (*assignment)[v];
+            auto range = neighbors(v);
+            for(auto w = range.first; w != range.second; ++w)
+                local += (*assignment)[*w] != c || c == SINGLETON_CLUSTER;
+            across[t] += local;
+        }, threads
+    );
+    unsigned long total = 0ul;
+    for(auto a: across)
+        total += a;
+    return total / 2;
+}
+
+ClusteringCost clustering_cost(GraphCSR *g, const std::vector<unsigned long> *assignment,
+    unsigned int num_threads)
+{
+    PhaseTimer timer(PHASE_CLUSTERING_COST);
+    if (assignment->size() != g->get_n())
+        throw std::invalid_argument("clustering_cost: the assignment has " + std::to_string(assignment->size())
+            + " vertices, the graph has " + std::to_string(g->get_n()) + ".");
+    auto neighbors = g->get_neighbors();
+    auto offsets = g->get_offsets();
+    auto across = count_across(assignment,
+        [neighbors, offsets](unsigned long v) {
+            return std::make_pair(neighbors + offsets[v], neighbors + offsets[v + 1]);
+        }, num_threads);
+    return cost_from_sizes(assignment, [](unsigned long) { return true; }, g->get_positive_m(), across);
+}
+
+ClusteringCost clustering_cost(Graph *g, const std::vector<unsigned long> *assignment,
+    unsigned int num_threads)
+{
+    PhaseTimer timer(PHASE_CLUSTERING_COST);
+    if (assignment->size() != g->get_id_bound())
+        throw std::invalid_argument("clustering_cost: the assignment has " + std::to_string(assignment->size())
+            + " vertex ids, the graph has " + std::to_string(g->get_id_bound()) + ".");
+    auto across = count_across(assignment,
+        [g](unsigned long v) {
+            auto neigh_v = g->get_neighborhood(v);
+            //< nullptr for a removed vertex
+            const vertex_id_t *first = (neigh_v == nullptr) ? nullptr : neigh_v->data();
+            return std::make_pair(first, first + ((neigh_v == nullptr) ? 0ul : neigh_v->size()));
+        }, num_threads);
+    return cost_from_sizes(assignment, [g](unsigned long v) { return g->get_neighborhood(v) != nullptr; },
+        g->get_positive_m(), across);
+}
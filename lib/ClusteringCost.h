@@ -0,0 +1,68 @@
+/**
+ * @file ClusteringCost.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief The disagreement cost of a clustering on the complete signed graph
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef CLUSTERING_COST_H_
+#define CLUSTERING_COST_H_
+
+#include <vector>
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "ClusteringSink.h"
+
+/**
+ * @brief The disagreements of a clustering: every pair of vertices which is
+ * not a positive edge is a negative edge of the complete signed graph.
+ */
+struct ClusteringCost {
+    unsigned long positive_across;
+    ///< the positive edges whose endpoints are in different clusters
+    unsigned long negative_within;
+    ///< the pairs of vertices in the same cluster which are not positive edges
+    unsigned long clusters;
+    ///< the number of non-empty clusters
+    /**
+     * @brief the correlation clustering cost, i.e., the number of disagreements
+     *
+     * @return unsigned long
+     */
+    unsigned long total() const { return this->positive_across + this->negative_within; };
+};
+
+/**
+ * @brief the disagreement cost of assignment on the snapshot g, in O(n + m)
+ * @details The positive edges are scanned once, in parallel, counting those
+ * across clusters; the negative pairs within the clusters are never listed,
+ * as they are sum_C |C| (|C| - 1) / 2 minus the positive edges within.
+ * The labels may be any values; a vertex labeled SINGLETON_CLUSTER is
+ * alone in its cluster.
+ *
+ * @param g the CSR snapshot of graph G
+ * @param assignment the cluster of every vertex, of size g->get_n()
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return ClusteringCost
+ * @throws std::invalid_argument if the assignment is not of size g->get_n()
+ */
+ClusteringCost clustering_cost(GraphCSR *g, const std::vector<unsigned long> *assignment,
+    unsigned int num_threads = 0u);
+
+/**
+ * @brief the disagreement cost of assignment on the dynamic graph g, in
+ * O(n + m); the removed vertices are not part of any cluster, and a vertex
+ * labeled SINGLETON_CLUSTER is alone in its cluster
+ *
+ * @param g graph G
+ * @param assignment the cluster of every vertex id, of size g->get_id_bound()
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return ClusteringCost
+ * @throws std::invalid_argument if the assignment is not of size g->get_id_bound()
+ */
+ClusteringCost clustering_cost(Graph *g, const std::vector<unsigned long> *assignment,
+    unsigned int num_threads = 0u);
+
+#endif // CLUSTERING_COST_H_
@@ -0,0 +1,516 @@
+#include "ClusteringSink.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * @brief A file written from a buffer of CLUSTERING_SINK_BUFFER_BYTES, so
+ * the file is written in large blocks whatever the sizes of the records
+ */
+class BufferedFile {
+    protected:
+        std::string filename;
+        ///< exact address to the file
+        std::ofstream out;
+        ///< the file
+        std::vector<char> buffer;
+        ///< the bytes not written yet, with room for CLUSTERING_SINK_BUFFER_BYTES more
+        unsigned long used;
+        ///< the number of bytes in the buffer
+    public:
+        BufferedFile(std::string filename) : filename(filename), out(filename, std::ios::out | std::ios::binary),
+            buffer(2 * CLUSTERING_SINK_BUFFER_BYTES), used(0ul)
+        {
+            if (!this->out.is_open())
+                throw std::invalid_argument("File error: " + filename);
+        };
+        /**
+         * @brief room for at least CLUSTERING_SINK_BUFFER_BYTES more bytes,
+         * to be committed by advance
+         *
+         * @return char*
+         */
+        char* reserve() {
+            if (this->used >= CLUSTERING_SINK_BUFFER_BYTES) {
+                this->out.write(this->buffer.data(), this->used);
+                this->used = 0ul;
+            }
+            return this->buffer.data() + this->used;
+        };
+        void advance(char *end) { this->used = end - this->buffer.data(); };
+        void append(const void *bytes, unsigned long count) {
+            auto p = static_cast<const char*>(bytes);
+            while (count > 0ul) {
+                auto chunk = std::min(count, CLUSTERING_SINK_BUFFER_BYTES);
+                char *at = this->reserve();
+                std::memcpy(at, p, chunk);
+                this->advance(at + chunk);
+                p += chunk;
+                count -= chunk;
+            }
+        };
+        void close() {
+            this->out.write(this->buffer.data(), this->used);
+            this->used = 0ul;
+            this->out.close();
+            if (!this->out)
+                throw std::invalid_argument("File error: " + this->filename);
+        };
+};
+
+/**
+ * @brief writes x in decimal at p, two digits at a time
+ *
+ * @param p the output buffer, with room for 20 digits
+ * @param x the number
+ * @return char* one past the last digit
+ */
+static inline char* append_number(char *p, unsigned long x) {
+    static const char PAIRS[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char digits[20];
+    char *end = digits + 20, *q = end;
+    while (x >= 100ul) {
+        auto pair = (x % 100ul) * 2;
+        x /= 100ul;
+        *--q = PAIRS[pair + 1];
+        *--q = PAIRS[pair];
+    }
+    if (x >= 10ul) {
+        *--q = PAIRS[x * 2 + 1];
+        *--q = PAIRS[x * 2];
+    }
+    else
+        *--q = static_cast<char>('0' + x);
+    std::memcpy(p, q, end - q);
+    return p + (end - q);
+}
+
+/**
+ * @brief writes x at p as an LEB128 varint, seven bits per byte
+ *
+ * @param p the output buffer, with room for 10 bytes
+ * @param x the number
+ * @return char* one past the last byte
+ */
+static inline char* append_varint(char *p, unsigned long x) {
+    while (x >= 0x80ul) {
+        *p++ = static_cast<char>((x & 0x7Ful) | 0x80ul);
+        x >>= 7;
+    }
+    *p++ = static_cast<char>(x);
+    return p;
+}
+
+/**
+ * @brief reads an LEB128 varint at p and moves p past it
+ *
+ * @param p the input, moved past the varint
+ * @param end the end of the input
+ * @param x the number read
+ * @return true if a whole varint was read
+ */
+static inline bool read_varint(const char *&p, const char *end, unsigned long &x) {
+    x = 0ul;
+    for(unsigned int shift = 0u; p < end && shift <= 63u; shift += 7u) {
+        auto byte = static_cast<unsigned char>(*p++);
+        x |= static_cast<unsigned long>(byte & 0x7Fu) << shift;
+        if (byte < 0x80u)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief the magic and the number of vertices of a binary or delta-varint file
+ *
+ * @param file the output file
+ * @param magic the magic of the format
+ * @param n the number of vertices
+ */
+static void write_header(BufferedFile &file, const char magic[8], unsigned long n) {
+    std::uint64_t n64 = n;
+    file.append(magic, 8);
+    file.append(&n64, sizeof(n64));
+}
+
+void TsvClusteringSink::write(std::string filename, const std::vector<unsigned long> *assignment) {
+    BufferedFile file(filename);
+    const unsigned long LINE_BYTES = 42ul;  //< two numbers of at most 20 digits, a tab and a newline
+    char *p = file.reserve(), *limit = p + CLUSTERING_SINK_BUFFER_BYTES - LINE_BYTES;
+    for(unsigned long v = 0ul; v < assignment->size(); ++v) {
+        if (p >= limit) {
+            file.advance(p);
+            p = file.reserve();
+            limit = p + CLUSTERING_SINK_BUFFER_BYTES - LINE_BYTES;
+        }
+        p = append_number(p, v);
+        *p++ = '\t';
+        p = append_number(p, (*assignment)[v]);
+        *p++ = '\n';
+    }
+    file.advance(p);
+    file.close();
+}
+
+void BinaryClusteringSink::write(std::string filename, const std::vector<unsigned long> *assignment) {
+    BufferedFile file(filename);
+    write_header(file, CLUSTERING_BINARY_MAGIC, assignment->size());
+    static_assert(sizeof(unsigned long) == sizeof(std::uint64_t), "the labels are written as 64-bit integers");
+    file.append(assignment->data(), assignment->size() * sizeof(unsigned long));
+    file.close();
+}
+
+void VarintClusteringSink::write(std::string filename, const std::vector<unsigned long> *assignment) {
+    BufferedFile file(filename);
+    write_header(file, CLUSTERING_VARINT_MAGIC, assignment->size());
+    const unsigned long VARINT_BYTES = 10ul;
+    char *p = file.reserve(), *limit = p + CLUSTERING_SINK_BUFFER_BYTES - VARINT_BYTES;
+    unsigned long previous = 0ul;
+    for(auto label: *assignment) {
+        if (p >= limit) {
+            file.advance(p);
+            p = file.reserve();
+            limit = p + CLUSTERING_SINK_BUFFER_BYTES - VARINT_BYTES;
+        }
+        // the zigzag code of label - previous, modulo 2^64
+        unsigned long delta = label - previous;
+        p = append_varint(p, (delta << 1) ^ static_cast<unsigned long>(static_cast<long>(delta) >> 63));
+        previous = label;
+    }
+    file.advance(p);
+    file.close();
+}
+
+ClusteringSink* make_clustering_sink(std::string format) {
+    if (format == "tsv")
+        return new TsvClusteringSink();
+    if (format == "binary")
+        return new BinaryClusteringSink();
+    if (format == "varint")
+        return new VarintClusteringSink();
+    throw std::invalid_argument("Unknown clustering format " + format + ", expected tsv, binary or varint.");
+}
+
+std::vector<unsigned long>* read_clustering(std::string filename) {
+    std::ifstream in_file(filename, std::ios::in | std::ios::binary);
+    if (!in_file.is_open())
+        throw std::invalid_argument("File error: " + filename);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    auto clustering = new std::vector<unsigned long>();
+    auto has_magic = [&bytes](const char magic[8]) {
+        return bytes.size() >= 8ul && std::memcmp(bytes.data(), magic, 8) == 0;
+    };
+    if (has_magic(CLUSTERING_BINARY_MAGIC) || has_magic(CLUSTERING_VARINT_MAGIC)) {
+        std::uint64_t n = 0;
+        if (bytes.size() < 8ul + sizeof(n)) {
+            delete clustering;
+            throw std::runtime_error("Truncated clustering file " + filename + ".");
+        }
+        std::memcpy(&n, bytes.data() + 8, sizeof(n));
+        const char *p = bytes.data() + 8 + sizeof(n), *end = bytes.data() + bytes.size();
+        if (has_magic(CLUSTERING_BINARY_MAGIC)) {
+            if (static_cast<unsigned long>(end - p) / sizeof(unsigned long) < n) {
+                delete clustering;
+                throw std::runtime_error("Truncated clustering file " + filename + ".");
+            }
+            clustering->resize(n);
+            std::memcpy(clustering->data(), p, n * sizeof(unsigned long));
+            return clustering;
+        }
+        clustering->reserve(n);
+        unsigned long previous = 0ul;
+        for(std::uint64_t v = 0; v < n; ++v) {
+            unsigned long code;
+            if (!read_varint(p, end, code)) {
+                delete clustering;
+                throw std::runtime_error("Truncated clustering file " + filename + ".");
+            }
+            previous += (code >> 1) ^ (0ul - (code & 1ul));
+            clustering->push_back(previous);
+        }
+        return clustering;
+    }
+    // the text format, one "vertex<TAB>cluster" per line
+    const char *p = bytes.data(), *end = bytes.data() + bytes.size();
+    auto next_number = [&p, end](unsigned long &x) {
+        while (p < end && (*p < '0' || *p > '9'))
+            ++p;
+        if (p == end)
+            return false;
+        x = 0ul;
+        while (p < end && *p >= '0' && *p <= '9')
+            x = x * 10ul + static_cast<unsigned long>(*p++ - '0');
+        return true;
+    };
+    unsigned long v, cluster;
+    while (next_number(v) && next_number(cluster)) {
+        if (v >= clustering->size())
+            clustering->resize(v + 1, SINGLETON_CLUSTER);
+        (*clustering)[v] = cluster;
+    }
+    return clustering;
+}
+
+/**
+ * @brief the smallest vertex of the cluster of every vertex
+ *
+ * @param assignment the cluster of every vertex id, with any labels
+ * @param representative the smallest vertex of the cluster of every vertex, of the same size
+ */
+static void smallest_vertices(const std::vector<unsigned long> *assignment, std::vector<unsigned long> &representative) {
+    auto n = assignment->size();
+    unsigned long max_label = 0ul;
+    for(auto label: *assignment)
+        max_label = std::max(max_label, label);
+    if (max_label <= n) {
+        // the labels of a union-find, 1 to the number of clusters
+        std::vector<unsigned long> first(max_label + 1, n);
+        for(unsigned long v = 0ul; v < n; ++v) {
+            auto &f = first[(*assignment)[v]];
+            if (f == n)
+                f = v;
+            representative[v] = f;
+        }
+    }
+    else {
+        std::unordered_map<unsigned long, unsigned long> first;
+        for(unsigned long v = 0ul; v < n; ++v)
+            representative[v] = first.emplace((*assignment)[v], v).first->second;
+    }
+}
+
+/**
+ * @brief appends x to bytes as an LEB128 varint
+ *
+ * @param bytes the output
+ * @param x the number
+ */
+static inline void push_varint(std::vector<char> &bytes, unsigned long x) {
+    char varint[10];
+    bytes.insert(bytes.end(), varint, append_varint(varint, x));
+}
+
+ClusteringChangeLogWriter::ClusteringChangeLogWriter(std::string filename, unsigned long n) {
+    this->file = new BufferedFile(filename);
+    this->n = n;
+    this->representative = new std::vector<unsigned long>(n);
+    this->next_representative = new std::vector<unsigned long>(n);
+    for(unsigned long v = 0ul; v < n; ++v)
+        (*this->representative)[v] = v;
+    this->num_levels = 0ul;
+    this->num_changes = 0ul;
+    write_header(*this->file, CLUSTERING_CHANGE_LOG_MAGIC, n);
+}
+
+ClusteringChangeLogWriter::~ClusteringChangeLogWriter() {
+    delete this->file;
+    delete this->representative;
+    delete this->next_representative;
+    this->file = nullptr;
+    this->representative = nullptr;
+    this->next_representative = nullptr;
+}
+
+void ClusteringChangeLogWriter::add_level(double eps, const std::vector<unsigned long> *assignment) {
+    if (assignment->size() != this->n)
+        throw std::invalid_argument("The clustering of a level has " + std::to_string(assignment->size())
+            + " vertices instead of " + std::to_string(this->n) + ".");
+    smallest_vertices(assignment, *this->next_representative);
+    auto &previous = *this->representative;
+    auto &current = *this->next_representative;
+    std::vector<char> relabels, moves;
+    unsigned long num_relabels = 0ul, num_moves = 0ul, last = 0ul;
+    // a cluster of the previous level goes wherever its representative goes
+    for(unsigned long b = 0ul; b < this->n; ++b) {
+        if (previous[b] == b && current[b] != b) {
+            push_varint(relabels, b - last);
+            push_varint(relabels, b - current[b]);
+            last = b;
+            ++num_relabels;
+        }
+    }
+    last = 0ul;
+    // the vertices which split from the representative of their previous cluster
+    for(unsigned long v = 0ul; v < this->n; ++v) {
+        if (current[v] != current[previous[v]]) {
+            push_varint(moves, v - last);
+            push_varint(moves, v - current[v]);
+            last = v;
+            ++num_moves;
+        }
+    }
+    std::vector<char> counts;
+    this->file->append(&eps, sizeof(eps));
+    push_varint(counts, num_relabels);
+    this->file->append(counts.data(), counts.size());
+    this->file->append(relabels.data(), relabels.size());
+    counts.clear();
+    push_varint(counts, num_moves);
+    this->file->append(counts.data(), counts.size());
+    this->file->append(moves.data(), moves.size());
+    std::swap(this->representative, this->next_representative);
+    this->num_levels++;
+    this->num_changes += num_relabels + num_moves;
+}
+
+void ClusteringChangeLogWriter::close() {
+    if (this->file == nullptr)
+        return;
+    this->file->close();
+    delete this->file;
+    this->file = nullptr;
+}
+
+ClusteringChangeLog::ClusteringChangeLog(std::string filename) {
+    std::ifstream in_file(filename, std::ios::in | std::ios::binary);
+    if (!in_file.is_open())
+        throw std::invalid_argument("File error: " + filename);
+    this->bytes = new std::vector<char>((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    this->eps = new std::vector<double>();
+    this->level_offset = new std::vector<unsigned long>();
+    auto release = [this]() {
+        delete this->bytes;
+        delete this->eps;
+        delete this->level_offset;
+    };
+    std::uint64_t n64 = 0;
+    if (this->bytes->size() < 8ul || std::memcmp(this->bytes->data(), CLUSTERING_CHANGE_LOG_MAGIC, 8) != 0) {
+        release();
+        throw std::invalid_argument("Not a clustering change log: " + filename);
+    }
+    if (this->bytes->size() < 8ul + sizeof(n64)) {
+        release();
+        throw std::runtime_error("Truncated clustering change log " + filename + ".");
+    }
+    std::memcpy(&n64, this->bytes->data() + 8, sizeof(n64));
+    this->n = n64;
+    // indexing and validating the levels, so they are replayed without any checks
+    const char *begin = this->bytes->data(), *p = begin + 8 + sizeof(n64), *end = begin + this->bytes->size();
+    auto read_changes = [this, &p, end]() {
+        unsigned long count, vertex = 0ul, gap, back;
+        if (!read_varint(p, end, count))
+            return false;
+        for(unsigned long i = 0ul; i < count; ++i) {
+            if (!read_varint(p, end, gap) || !read_varint(p, end, back))
+                return false;
+            vertex += gap;
+            if ((i > 0ul && gap == 0ul) || vertex >= this->n || back > vertex)
+                return false;
+        }
+        return true;
+    };
+    while (p < end) {
+        double level_eps;
+        if (static_cast<unsigned long>(end - p) < sizeof(level_eps)) {
+            release();
+            throw std::runtime_error("Truncated clustering change log " + filename + ".");
+        }
+        std::memcpy(&level_eps, p, sizeof(level_eps));
+        p += sizeof(level_eps);
+        this->eps->push_back(level_eps);
+        this->level_offset->push_back(p - begin);
+        if (!read_changes() || !read_changes()) {
+            release();
+            throw std::runtime_error("Truncated clustering change log " + filename + ".");
+        }
+    }
+}
+
+ClusteringChangeLog::~ClusteringChangeLog() {
+    delete this->bytes;
+    delete this->eps;
+    delete this->level_offset;
+    this->bytes = nullptr;
+    this->eps = nullptr;
+    this->level_offset = nullptr;
+}
+
+bool ClusteringChangeLog::is_change_log_file(std::string filename) {
+    std::ifstream in_file(filename, std::ios::in | std::ios::binary);
+    char magic[8];
+    if (!in_file.read(magic, 8))
+        return false;
+    return std::memcmp(magic, CLUSTERING_CHANGE_LOG_MAGIC, 8) == 0;
+}
+
+void ClusteringChangeLog::apply_level(unsigned long level, std::vector<unsigned long> &representative,
+    std::vector<unsigned long> &relabel)
+{
+    const char *end = this->bytes->data() + this->bytes->size();
+    const char *relabels = this->bytes->data() + (*this->level_offset)[level], *p = relabels;
+    unsigned long count, vertex = 0ul, gap, back;
+    read_varint(p, end, count);
+    for(unsigned long i = 0ul; i < count; ++i) {
+        read_varint(p, end, gap);
+        read_varint(p, end, back);
+        vertex += gap;
+        relabel[vertex] = vertex - back;
+    }
+    for(unsigned long v = 0ul; v < this->n; ++v)
+        representative[v] = relabel[representative[v]];
+    // the relabels are read again to restore the identity
+    const char *moves = p;
+    p = relabels;
+    vertex = 0ul;
+    read_varint(p, end, count);
+    for(unsigned long i = 0ul; i < count; ++i) {
+        read_varint(p, end, gap);
+        read_varint(p, end, back);
+        vertex += gap;
+        relabel[vertex] = vertex;
+    }
+    p = moves;
+    vertex = 0ul;
+    read_varint(p, end, count);
+    for(unsigned long i = 0ul; i < count; ++i) {
+        read_varint(p, end, gap);
+        read_varint(p, end, back);
+        vertex += gap;
+        representative[vertex] = vertex - back;
+    }
+}
+
+/**
+ * @brief the labels of the clusters, 1 to the number of clusters in the
+ * order of their smallest vertex
+ *
+ * @param representative the smallest vertex of the cluster of every vertex
+ * @return std::vector<unsigned long>*
+ */
+static std::vector<unsigned long>* representative_labels(const std::vector<unsigned long> &representative) {
+    auto labels = new std::vector<unsigned long>(representative.size());
+    unsigned long clusters = 0ul;
+    for(unsigned long v = 0ul; v < representative.size(); ++v)
+        (*labels)[v] = (representative[v] == v) ? ++clusters : (*labels)[representative[v]];
+    return labels;
+}
+
+std::vector<unsigned long>* ClusteringChangeLog::clustering(unsigned long level) {
+    if (level >= this->eps->size())
+        throw std::out_of_range("The change log has no level " + std::to_string(level) + ".");
+    std::vector<unsigned long> representative(this->n), relabel(this->n);
+    for(unsigned long v = 0ul; v < this->n; ++v)
+        representative[v] = relabel[v] = v;
+    for(unsigned long l = 0ul; l <= level; ++l)
+        this->apply_level(l, representative, relabel);
+    return representative_labels(representative);
+}
+
+std::vector<std::vector<unsigned long>*>* ClusteringChangeLog::clusterings() {
+    auto levels = new std::vector<std::vector<unsigned long>*>();
+    std::vector<unsigned long> representative(this->n), relabel(this->n);
+    for(unsigned long v = 0ul; v < this->n; ++v)
+        representative[v] = relabel[v] = v;
+    for(unsigned long l = 0ul; l < this->eps->size(); ++l) {
+        this->apply_level(l, representative, relabel);
+        levels->push_back(representative_labels(representative));
+    }
+    return levels;
+}
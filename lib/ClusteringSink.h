@@ -0,0 +1,250 @@
+/**
+ * @file ClusteringSink.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Buffered writers and a reader of clustering files in text, binary and compressed formats
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef CLUSTERING_SINK_H_
+#define CLUSTERING_SINK_H_
+
+#include <string>
+#include <vector>
+#include <limits>
+
+const char CLUSTERING_BINARY_MAGIC[8] = {'H', 'C', 'C', 'L', 'B', 'I', 'N', '\0'};
+///< @note the first eight bytes of a binary clustering file
+const char CLUSTERING_VARINT_MAGIC[8] = {'H', 'C', 'C', 'L', 'V', 'A', 'R', '\0'};
+///< @note the first eight bytes of a delta-varint clustering file
+const unsigned long CLUSTERING_SINK_BUFFER_BYTES = 1ul << 20;
+///< @note the bytes collected before each write to the file
+const unsigned long SINGLETON_CLUSTER = std::numeric_limits<unsigned long>::max();
+///< @note the label of a vertex which is alone in its cluster, e.g. one missing from a clustering file
+
+/**
+ * @brief Writes the cluster assignment of a query into a file, in the
+ * format of the sink.
+ * @details All the formats store the cluster of every vertex id in order,
+ * so the files of the same assignment have the same content in any format.
+ * A binary or delta-varint file starts with its 8-byte magic followed by
+ * the number of vertices as a 64-bit integer, in native byte order.
+ */
+class ClusteringSink {
+    public:
+        /**
+         * @brief Destroy the Clustering Sink object
+         *
+         */
+        virtual ~ClusteringSink() {};
+        /**
+         * @brief writes the assignment into filename, replacing it
+         * @throws std::invalid_argument if the file cannot be written
+         *
+         * @param filename exact address to the output file
+         * @param assignment the cluster of every vertex id
+         */
+        virtual void write(std::string filename, const std::vector<unsigned long> *assignment) = 0;
+        /**
+         * @brief the file name extension of the format, with the dot
+         *
+         * @return std::string
+         */
+        virtual std::string extension() const = 0;
+};
+
+/**
+ * @brief one "vertex<TAB>cluster" line per vertex, formatted by a
+ * hand-rolled integer formatter into a large buffer instead of a stream
+ * which is flushed on every line
+ */
+class TsvClusteringSink : public ClusteringSink {
+    public:
+        void write(std::string filename, const std::vector<unsigned long> *assignment) override;
+        std::string extension() const override { return ".out"; };
+};
+
+/**
+ * @brief the clusters as a raw array of 64-bit integers, which can be
+ * mapped and used in place
+ */
+class BinaryClusteringSink : public ClusteringSink {
+    public:
+        void write(std::string filename, const std::vector<unsigned long> *assignment) override;
+        std::string extension() const override { return ".bin"; };
+};
+
+/**
+ * @brief the difference of the cluster of each vertex from the cluster of
+ * the previous vertex, zigzag-encoded as an LEB128 varint
+ * @details The clusters are numbered in the order of their smallest vertex,
+ * so consecutive vertices of the same cluster take one byte each.
+ */
+class VarintClusteringSink : public ClusteringSink {
+    public:
+        void write(std::string filename, const std::vector<unsigned long> *assignment) override;
+        std::string extension() const override { return ".vz"; };
+};
+
+/**
+ * @brief the sink of a format given by name
+ * @throws std::invalid_argument if the format is unknown
+ *
+ * @param format one of "tsv", "binary" or "varint"
+ * @return ClusteringSink* owned by the caller
+ */
+ClusteringSink* make_clustering_sink(std::string format);
+
+/**
+ * @brief reads a clustering file of any of the formats, which is detected
+ * from its first bytes; the vertices missing from a text file are labeled
+ * SINGLETON_CLUSTER
+ * @throws std::invalid_argument if the file cannot be opened
+ * @throws std::runtime_error if a binary or delta-varint file is truncated
+ *
+ * @param filename exact address to the clustering file
+ * @return std::vector<unsigned long>* the cluster of every vertex id
+ */
+std::vector<unsigned long>* read_clustering(std::string filename);
+
+const char CLUSTERING_CHANGE_LOG_MAGIC[8] = {'H', 'C', 'C', 'L', 'L', 'O', 'G', '\0'};
+///< @note the first eight bytes of a clustering change log
+
+class BufferedFile;
+
+/**
+ * @brief Writes the clusterings of a sequence of levels, e.g., an eps
+ * schedule, as the changes from each level to the next, so a hierarchy of
+ * nearly nested clusterings takes a fraction of the space of one file per
+ * level.
+ * @details A cluster is represented by its smallest vertex. The levels are
+ * stored as transitions, the first one from the level of singletons: the
+ * relabels map the representative of a cluster of the previous level to
+ * its representative at the new level, which covers the merges, and the
+ * moves give the new representative of the vertices which are not where
+ * the relabels take them, which covers the splits. Both are sorted by
+ * vertex and stored as the varint gaps between the vertices and the varint
+ * distances from each vertex down to its new representative.
+ *
+ * The file is the magic, the number of vertices as a 64-bit integer, and
+ * for every level the eps as a double, the number of relabels, the
+ * relabels, the number of moves and the moves, in native byte order.
+ */
+class ClusteringChangeLogWriter {
+    protected:
+        BufferedFile *file;
+        ///< the change log, or nullptr after close
+        unsigned long n;
+        ///< the number of vertices of every level
+        std::vector<unsigned long> *representative;
+        ///< the representative of every vertex at the last level
+        std::vector<unsigned long> *next_representative;
+        ///< the representative of every vertex at the level being added
+        unsigned long num_levels;
+        ///< the number of levels written
+        unsigned long num_changes;
+        ///< the number of relabels and moves written
+    public:
+        /**
+         * @brief Construct a new Clustering Change Log Writer object
+         * @throws std::invalid_argument if the file cannot be written
+         *
+         * @param filename exact address to the output file
+         * @param n the number of vertices of every level
+         */
+        ClusteringChangeLogWriter(std::string filename, unsigned long n);
+        /**
+         * @brief Destroy the Clustering Change Log Writer object; the levels
+         * are only written by close
+         *
+         */
+        ~ClusteringChangeLogWriter();
+        /**
+         * @brief appends the changes from the last level to this one
+         * @throws std::invalid_argument if the assignment is not of n vertices
+         *
+         * @param eps the eps of the level
+         * @param assignment the cluster of every vertex id, with any labels
+         */
+        void add_level(double eps, const std::vector<unsigned long> *assignment);
+        /**
+         * @brief writes the pending levels and closes the file
+         * @throws std::invalid_argument if the file cannot be written
+         *
+         */
+        void close();
+        unsigned long get_num_levels() { return this->num_levels; };
+        unsigned long get_num_changes() { return this->num_changes; };
+};
+
+/**
+ * @brief Reads a clustering change log, see ClusteringChangeLogWriter, and
+ * reconstructs the clustering of any level on demand
+ *
+ */
+class ClusteringChangeLog {
+    protected:
+        std::vector<char> *bytes;
+        ///< the whole file
+        unsigned long n;
+        ///< the number of vertices of every level
+        std::vector<double> *eps;
+        ///< the eps of every level
+        std::vector<unsigned long> *level_offset;
+        ///< the offset of the transition of every level in bytes
+        /**
+         * @brief applies the transition of a level to the representatives
+         * of the previous level
+         *
+         * @param level the level
+         * @param representative the representative of every vertex, updated in place
+         * @param relabel the identity on the vertices, restored on return
+         */
+        void apply_level(unsigned long level, std::vector<unsigned long> &representative,
+            std::vector<unsigned long> &relabel);
+    public:
+        /**
+         * @brief Construct a new Clustering Change Log object
+         * @throws std::invalid_argument if the file cannot be opened or is not a change log
+         * @throws std::runtime_error if the file is truncated
+         *
+         * @param filename exact address to the change log
+         */
+        ClusteringChangeLog(std::string filename);
+        /**
+         * @brief Destroy the Clustering Change Log object
+         *
+         */
+        ~ClusteringChangeLog();
+        /**
+         * @brief whether a file starts with CLUSTERING_CHANGE_LOG_MAGIC
+         *
+         * @param filename exact address to the file
+         * @return true if the file is a change log
+         */
+        static bool is_change_log_file(std::string filename);
+        unsigned long get_n() { return this->n; };
+        unsigned long get_num_levels() { return this->eps->size(); };
+        double get_eps(unsigned long level) { return this->eps->at(level); };
+        /**
+         * @brief the clustering of a level, by replaying the transitions of
+         * the levels up to it in O((level + 1) n) time
+         * @throws std::out_of_range if there is no such level
+         *
+         * @param level the level, in the order the levels were written
+         * @return std::vector<unsigned long>* the cluster assignment (starting
+         * at 1, in the order of the smallest vertex of every cluster), which
+         * is the one of a union-find's labels
+         */
+        std::vector<unsigned long>* clustering(unsigned long level);
+        /**
+         * @brief the clusterings of all the levels in one pass, in O(levels n) time
+         *
+         * @return std::vector<std::vector<unsigned long>*>* the cluster
+         * assignment of every level, as in clustering
+         */
+        std::vector<std::vector<unsigned long>*>* clusterings();
+};
+
+#endif // CLUSTERING_SINK_H_
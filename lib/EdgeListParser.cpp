@@ -0,0 +1,167 @@
+#include "EdgeListParser.h"
+#include "Parallel.h"
+#include <chrono>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const unsigned int CHUNKS_PER_THREAD = 8u;
+///< @note more chunks than threads, so an unlucky split does not leave a thread idle
+
+/**
+ * @brief reads a decimal number starting at *p, which should be a digit
+ *
+ * @param p the cursor, moved past the number
+ * @param end the end of the buffer
+ * @return unsigned long
+ */
+static inline unsigned long parse_number(const char *&p, const char *end) {
+    unsigned long value = 0ul;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10ul + static_cast<unsigned long>(*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+static inline bool is_digit(const char *p, const char *end) {
+    return p < end && *p >= '0' && *p <= '9';
+}
+
+static inline void skip_blanks(const char *&p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+}
+
+/**
+ * @brief parses all the "u v" lines of [begin, end)
+ *
+ * @param begin the first character of a line
+ * @param end one past the last newline of the chunk, or the end of the file
+ * @param file the start of the file, for the error messages
+ * @param edges the buffer to append the edges to
+ */
+static void parse_chunk(const char *begin, const char *end, const char *file,
+    std::vector<std::pair<unsigned long, unsigned long>> *edges)
+{
+    auto p = begin;
+    while (p < end) {
+        skip_blanks(p, end);
+        if (p == end)
+            break;
+        if (*p == '\n') {
+            ++p;
+            continue;
+        }
+        if (*p == '#') {
+            while (p < end && *p != '\n')
+                ++p;
+            continue;
+        }
+        if (!is_digit(p, end))
+            throw std::runtime_error("Expected a vertex id at byte " + std::to_string(p - file));
+        auto u = parse_number(p, end);
+        skip_blanks(p, end);
+        if (!is_digit(p, end))
+            throw std::runtime_error("Expected a second vertex id at byte " + std::to_string(p - file));
+        auto v = parse_number(p, end);
+        skip_blanks(p, end);
+        if (p < end && *p != '\n')
+            throw std::runtime_error("Unexpected character at byte " + std::to_string(p - file));
+        edges->push_back(std::make_pair(u, v));
+    }
+}
+
+EdgeListParser::EdgeListParser(std::string input, unsigned int num_threads) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    this->threads = resolve_num_threads(num_threads);
+    this->n = 0ul;
+    this->declared_m = 0ul;
+    this->edges = new std::vector<std::pair<unsigned long, unsigned long>>();
+    auto fd = open(input.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::invalid_argument("File error: " + input);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw std::invalid_argument("File error: " + input);
+    }
+    this->bytes = file_stat.st_size;
+    if (this->bytes == 0ul) {
+        close(fd);
+        throw std::runtime_error("The edge list " + input + " is empty");
+    }
+    auto mapped = mmap(nullptr, this->bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        throw std::invalid_argument("File error: " + input);
+    madvise(mapped, this->bytes, MADV_SEQUENTIAL);
+    auto file = static_cast<const char*>(mapped);
+    auto file_end = file + this->bytes;
+    auto chunk_buffers = new std::vector<std::vector<std::pair<unsigned long, unsigned long>>>();
+    try {
+        // the header: n m
+        auto p = file;
+        while (p < file_end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+            ++p;
+        if (!is_digit(p, file_end))
+            throw std::runtime_error("Expected the number of vertices at byte " + std::to_string(p - file));
+        this->n = parse_number(p, file_end);
+        skip_blanks(p, file_end);
+        if (!is_digit(p, file_end))
+            throw std::runtime_error("Expected the number of edges at byte " + std::to_string(p - file));
+        this->declared_m = parse_number(p, file_end);
+        auto body = p;
+        // splitting the body at newlines
+        unsigned long num_chunks = this->threads * CHUNKS_PER_THREAD;
+        auto chunk_size = (file_end - body) / num_chunks + 1;
+        std::vector<const char*> boundaries(1, body);
+        for(unsigned long k = 1ul; k < num_chunks; ++k) {
+            auto q = std::max(boundaries.back(), body + std::min<unsigned long>(k * chunk_size, file_end - body));
+            while (q < file_end && *(q - 1) != '\n')
+                ++q;
+            boundaries.push_back(q);
+        }
+        boundaries.push_back(file_end);
+        chunk_buffers->resize(num_chunks);
+        for(auto &buffer: *chunk_buffers)
+            buffer.reserve((chunk_size >> 3) + 1); // a "u v\n" line takes at least 4 bytes, usually more
+        // the exceptions cannot leave the worker threads, so they are collected per chunk
+        std::vector<std::string> errors(num_chunks);
+        parallel_for(0ul, num_chunks, [&](unsigned long k) {
+            try {
+                parse_chunk(boundaries[k], boundaries[k + 1], file, &(*chunk_buffers)[k]);
+            }
+            catch (std::exception &e) {
+                errors[k] = e.what();
+            }
+        }, this->threads);
+        for(auto &error: errors) {
+            if (!error.empty())
+                throw std::runtime_error(error);
+        }
+        // concatenating the chunk buffers in order
+        std::vector<unsigned long> starts(num_chunks + 1, 0ul);
+        for(unsigned long k = 0ul; k < num_chunks; ++k)
+            starts[k + 1] = starts[k] + (*chunk_buffers)[k].size();
+        this->edges->resize(starts.back());
+        parallel_for(0ul, num_chunks, [&](unsigned long k) {
+            std::copy((*chunk_buffers)[k].begin(), (*chunk_buffers)[k].end(), this->edges->begin() + starts[k]);
+        }, this->threads);
+    }
+    catch (std::exception &e) {
+        delete chunk_buffers;
+        delete this->edges;
+        munmap(mapped, this->bytes);
+        throw std::runtime_error("Error in parsing " + input + ": " + e.what());
+    }
+    delete chunk_buffers;
+    munmap(mapped, this->bytes);
+    this->seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t1).count();
+}
+
+EdgeListParser::~EdgeListParser() {
+    delete this->edges;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file EdgeListParser.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Parallel parser of the text edge-list files
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef EDGE_LIST_PARSER_H_
+#define EDGE_LIST_PARSER_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Reads a text edge list, i.e., a line "n m" followed by one "u v"
+ * line per positive edge (see Graph::load_from_file), in parallel.
+ * @details The file is mapped read-only and the part after the header is
+ * split into chunks which start right after a newline, so no line crosses
+ * two chunks. Every chunk is parsed by a hand-rolled integer scanner into
+ * its own edge buffer, and the buffers are then concatenated in parallel in
+ * the order of the chunks, so the edges keep the order of the file. Blank
+ * lines and lines starting with '#' are skipped.
+ */
+class EdgeListParser {
+    protected:
+        unsigned long n;
+        ///< the number of vertices given in the header
+        unsigned long declared_m;
+        ///< the number of edges given in the header
+        std::vector<std::pair<unsigned long, unsigned long>> *edges;
+        ///< the edges in the order of the file, as given (not symmetrized or deduplicated)
+        unsigned long bytes;
+        ///< the size of the file
+        double seconds;
+        ///< the wall-clock time of parsing
+        unsigned int threads;
+        ///< the number of threads used
+    public:
+        /**
+         * @brief parses the edge list file input
+         * @throws std::invalid_argument if the file cannot be opened
+         * @throws std::runtime_error if the file is malformed, the message has the byte offset
+         *
+         * @param input exact address to the input file
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        EdgeListParser(std::string input, unsigned int num_threads = 0u);
+        /**
+         * @brief Destroy the Edge List Parser object
+         *
+         */
+        ~EdgeListParser();
+        /**
+         * @brief the number of vertices given in the header
+         *
+         * @return unsigned long
+         */
+        unsigned long get_n() { return this->n; };
+        /**
+         * @brief the number of edges given in the header, which may differ
+         * from the number of edge lines if there are duplicates
+         *
+         * @return unsigned long
+         */
+        unsigned long get_declared_m() { return this->declared_m; };
+        /**
+         * @brief the parsed edges, owned by the parser
+         *
+         * @return const std::vector<std::pair<unsigned long, unsigned long>>*
+         */
+        const std::vector<std::pair<unsigned long, unsigned long>> * get_edges() { return this->edges; };
+        /**
+         * @brief the size of the parsed file in bytes
+         *
+         * @return unsigned long
+         */
+        unsigned long get_bytes() { return this->bytes; };
+        /**
+         * @brief the time spent parsing, in seconds
+         *
+         * @return double
+         */
+        double get_seconds() { return this->seconds; };
+        /**
+         * @brief the parsing throughput in MB/s (10^6 bytes per second)
+         *
+         * @return double
+         */
+        double get_throughput() { return (this->seconds > 0.0) ? this->bytes / 1e6 / this->seconds : 0.0; };
+        /**
+         * @brief the number of threads used for parsing
+         *
+         * @return unsigned int
+         */
+        unsigned int get_num_threads() { return this->threads; };
+};
+
+#endif // EDGE_LIST_PARSER_H_
@@ -0,0 +1,43 @@
+#include "EdgeOrder.h"
+#include "Parallel.h"
+#include "Stats.h"
+
+EdgeOrder::EdgeOrder(NAOArena *naos, unsigned int num_threads) {
+    this->naos = naos;
+    this->edges = new std::vector<OrderedEdge>();
+    this->rebuild(num_threads);
+}
+
+EdgeOrder::~EdgeOrder() {
+    delete this->edges;
+}
+
+void EdgeOrder::rebuild(unsigned int num_threads) {
+    PhaseTimer timer(PHASE_EDGE_ORDER);
+    this->built_epoch = this->naos->advance_epoch();
+    this->built_n = this->naos->get_n();
+    this->changed_reads = 0ul;
+    this->edges->clear();
+    this->naos->get_live_vertices()->for_each([this](unsigned long u) {
+        auto keys_u = this->naos->keys_of(u);
+        auto ids_u = this->naos->ids_of(u);
+        for(unsigned long k = 0ul; k < this->naos->size(u); ++k) {
+            if (u < ids_u[k])
+                this->edges->push_back(OrderedEdge{keys_u[k], static_cast<nao_id_t>(u), ids_u[k]});
+        }
+    });
+    parallel_radix_sort(*this->edges, [](const OrderedEdge &e) { return static_cast<na_key_t>(e.key); }, num_threads);
+}
+
+unsigned long EdgeOrder::changed_entries() const {
+    unsigned long entries = 0ul;
+    this->naos->get_live_vertices()->for_each([this, &entries](unsigned long v) {
+        if (this->is_changed(v))
+            entries += this->naos->size(v);
+    });
+    return entries;
+}
+
+bool EdgeOrder::is_worth_rebuilding() const {
+    return this->changed_reads > EDGE_ORDER_REBUILD_FACTOR * this->edges->size();
+}
@@ -0,0 +1,173 @@
+/**
+ * @file EdgeOrder.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief A global index of the positive edges in the order of their non-agreements
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef EDGE_ORDER_H_
+#define EDGE_ORDER_H_
+
+#include <vector>
+#include <algorithm>
+#include "NAOArena.h"
+#include "Parallel.h"
+#include "Stats.h"
+
+const unsigned long EDGE_ORDER_REBUILD_FACTOR = 2ul;
+///< @note the order is rebuilt once the queries read this many times more entries of
+///< changed NAOs, since the last rebuild, than there are edges in the order
+const unsigned long EDGE_ORDER_GRAIN = 4096ul;
+///< @note the fewest edges of the prefix given to a thread
+
+/**
+ * @brief a positive edge {u,v} with u < v and the key of its non-agreement
+ */
+struct OrderedEdge {
+    nao_key_t key;  //< the key of NonAgreement(u,v), as stored in the NAOs
+    nao_id_t u;     //< the smaller endpoint
+    nao_id_t v;     //< the larger endpoint
+};
+
+/**
+ * @brief All the positive edges, once each, sorted by non-agreement, so the
+ * eps-agreement edges of any eps are one contiguous prefix.
+ * @details Edges of vertices whose NAO changed since the last rebuild are
+ * read from their NAOs instead; the owner rebuilds once is_worth_rebuilding().
+ */
+class EdgeOrder {
+    protected:
+        NAOArena *naos;
+        ///< the NAOs the edges are read from, not owned
+        std::vector<OrderedEdge> *edges;
+        ///< sorted by key
+        unsigned long built_epoch;
+        ///< the epoch of the NAOs at the last rebuild
+        unsigned long built_n;
+        ///< the number of vertex ids at the last rebuild
+        unsigned long changed_reads;
+        ///< the entries of changed NAOs read by the queries since the last rebuild
+        /**
+         * @brief true iff NAO(v) changed since the last rebuild, or v is newer than it
+         *
+         * @param v vertex id
+         * @return bool
+         */
+        bool is_changed(unsigned long v) const {
+            return v >= this->built_n || this->naos->changed_at(v) > this->built_epoch;
+        };
+    public:
+        /**
+         * @brief builds the order of the edges of the NAOs
+         *
+         * @param naos the NAOs of all the vertices, which must outlive this object
+         * @param num_threads number of threads to sort the edges, 0 means all hardware threads
+         */
+        EdgeOrder(NAOArena *naos, unsigned int num_threads = 0u);
+        /**
+         * @brief Destroy the EdgeOrder object
+         *
+         */
+        ~EdgeOrder();
+        EdgeOrder(const EdgeOrder &) = delete;
+        EdgeOrder &operator=(const EdgeOrder &) = delete;
+        /**
+         * @brief sorts the edges of the NAOs again, so no vertex counts as changed
+         *
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void rebuild(unsigned int num_threads = 0u);
+        /**
+         * @brief the number of NAO entries of the vertices changed since the last rebuild
+         *
+         * @return unsigned long
+         */
+        unsigned long changed_entries() const;
+        /**
+         * @brief true iff the queries since the last rebuild have read more
+         * entries of changed NAOs than EDGE_ORDER_REBUILD_FACTOR times the edges
+         *
+         * @return bool
+         */
+        bool is_worth_rebuilding() const;
+        /**
+         * @brief the number of ordered edges whose key is below threshold
+         *
+         * @param threshold to_nao_threshold(eps_to_key(eps))
+         * @return unsigned long
+         */
+        unsigned long prefix_length(na_key_t threshold) const {
+            return std::lower_bound(this->edges->begin(), this->edges->end(), threshold,
+                [](const OrderedEdge &e, na_key_t t) { return e.key < t; }) - this->edges->begin();
+        };
+        /**
+         * @brief calls fn(u, v, t) in parallel once for every positive edge
+         * {u,v} whose non-agreement is below eps in the current NAOs, where t
+         * is the index of the calling thread
+         *
+         * @param threshold to_nao_threshold(eps_to_key(eps))
+         * @param fn called as fn(u, v, t), concurrently for distinct t
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        template<typename F>
+        void for_each_agreeing(na_key_t threshold, F fn, unsigned int num_threads = 1u) {
+            // once half of the entries changed, reading the prefix of every NAO is cheaper
+            bool use_order = this->changed_entries() < this->edges->size();
+            auto end = use_order ? this->prefix_length(threshold) : 0ul;
+            // the prefix of the order, without the edges of the changed vertices
+            auto threads = std::max<unsigned long>(1ul,
+                std::min<unsigned long>(resolve_num_threads(num_threads), end / EDGE_ORDER_GRAIN));
+            auto block = (end + threads - 1) / threads;
+            parallel_for(0ul, threads, [&](unsigned long t) {
+                for(unsigned long i = t * block; i < std::min(end, (t + 1) * block); ++i) {
+                    auto &e = (*this->edges)[i];
+                    if (!this->is_changed(e.u) && !this->is_changed(e.v))
+                        fn(static_cast<unsigned long>(e.u), static_cast<unsigned long>(e.v), static_cast<unsigned int>(t));
+                }
+            }, threads);
+            // the edges of the changed vertices, from their own NAOs, once each
+            std::vector<unsigned long> reads(resolve_num_threads(num_threads), 0ul);
+            parallel_for_weighted_indexed(this->naos->get_n(),
+                [&](unsigned long u) {
+                    return (use_order && !this->is_changed(u)) ? 0.01 : this->naos->size(u) + 1.0;
+                },
+                [&](unsigned long u, unsigned int t) {
+                    if ((use_order && !this->is_changed(u)) || !this->naos->has(u))
+                        return;
+                    auto keys_u = this->naos->keys_of(u);
+                    auto ids_u = this->naos->ids_of(u);
+                    unsigned long deg = this->naos->size(u);
+                    unsigned long k = 0ul;
+                    for(; k < deg && keys_u[k] < threshold; ++k) {
+                        unsigned long v = ids_u[k];
+                        if (u < v || (use_order && !this->is_changed(v)))
+                            fn(u, v, t);
+                    }
+                    reads[t] += k + 1;
+                }, num_threads
+            );
+            unsigned long changed_reads = 0ul;
+            for(auto r: reads)
+                changed_reads += r;
+            this->changed_reads += changed_reads;
+            stat_add(STAT_NAO_ENTRIES_SCANNED, end + changed_reads);
+        };
+        /**
+         * @brief the number of edges in the order
+         *
+         * @return unsigned long
+         */
+        unsigned long size() const { return this->edges->size(); };
+        /**
+         * @brief the number of bytes allocated by the order
+         *
+         * @return unsigned long
+         */
+        unsigned long memory_bytes() const {
+            return sizeof(EdgeOrder) + this->edges->capacity() * sizeof(OrderedEdge);
+        };
+};
+
+#endif // EDGE_ORDER_H_
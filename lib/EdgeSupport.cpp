@@ -0,0 +1,98 @@
+#include "EdgeSupport.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <atomic>
+#include <limits>
+
+EdgeSupport::EdgeSupport(GraphCSR *g, unsigned int num_threads) {
+    PhaseTimer timer(PHASE_EDGE_SUPPORT);
+    this->g = g;
+    auto n = g->get_n();
+    auto slots = 2 * g->get_positive_m();
+    // ranking the vertices by (degree, id) and orienting each edge towards the higher rank
+    auto rank_less = [g](unsigned long a, unsigned long b) {
+        auto deg_a = g->deg_positive(a), deg_b = g->deg_positive(b);
+        return deg_a < deg_b || (deg_a == deg_b && a < b);
+    };
+    auto out_offsets = new std::vector<unsigned long>(n + 1, 0ul);
+    for(unsigned long u = 0ul; u < n; ++u) {
+        unsigned long out_deg = 0ul;
+        for(auto it = g->neighborhood_begin(u); it != g->neighborhood_end(u); ++it)
+            out_deg += rank_less(u, *it);
+        (*out_offsets)[u + 1] = (*out_offsets)[u] + out_deg;
+    }
+    auto out_slots = new std::vector<unsigned long>(out_offsets->back());
+    //< the CSR slot of each oriented edge (u,v) inside N^+(u), in increasing order of v
+    parallel_for(0ul, n, [&](unsigned long u) {
+        auto next = (*out_offsets)[u];
+        for(auto slot = g->get_offset(u); slot < g->get_offset(u + 1); ++slot) {
+            if (rank_less(u, g->neighbor_at(slot)))
+                (*out_slots)[next++] = slot;
+        }
+    }, num_threads);
+    // counting the triangles on each oriented edge
+    auto support = new std::vector<std::atomic<unsigned long>>(slots);
+    const unsigned long NOT_MARKED = std::numeric_limits<unsigned long>::max();
+    auto threads = resolve_num_threads(num_threads);
+    auto markers = new std::vector<std::vector<unsigned long>>(threads);
+    //< markers[t][w] is the slot of (u,w) if w is an out-neighbor of the vertex u thread t is on
+    parallel_for_weighted_indexed(n,
+        [&](unsigned long u) {
+            double out_deg = (*out_offsets)[u + 1] - (*out_offsets)[u];
+            return out_deg * out_deg + 1.0;
+        },
+        [&](unsigned long u, unsigned int t) {
+            auto marker = &(*markers)[t];
+            if (marker->empty())
+                marker->assign(n, NOT_MARKED);
+            for(auto i = (*out_offsets)[u]; i < (*out_offsets)[u + 1]; ++i)
+                (*marker)[g->neighbor_at((*out_slots)[i])] = (*out_slots)[i];
+            stat_add(STAT_INTERSECTIONS, (*out_offsets)[u + 1] - (*out_offsets)[u]);
+            //< one intersection of N+(u) and N+(v) per oriented edge (u,v), against the marker
+            for(auto i = (*out_offsets)[u]; i < (*out_offsets)[u + 1]; ++i) {
+                auto slot_uv = (*out_slots)[i];
+                auto v = g->neighbor_at(slot_uv);
+                for(auto j = (*out_offsets)[v]; j < (*out_offsets)[v + 1]; ++j) {
+                    auto slot_vw = (*out_slots)[j];
+                    auto slot_uw = (*marker)[g->neighbor_at(slot_vw)];
+                    if (slot_uw != NOT_MARKED) {
+                        (*support)[slot_uv].fetch_add(1ul, std::memory_order_relaxed);
+                        (*support)[slot_vw].fetch_add(1ul, std::memory_order_relaxed);
+                        (*support)[slot_uw].fetch_add(1ul, std::memory_order_relaxed);
+                    }
+                }
+            }
+            for(auto i = (*out_offsets)[u]; i < (*out_offsets)[u + 1]; ++i)
+                (*marker)[g->neighbor_at((*out_slots)[i])] = NOT_MARKED;
+        }, threads
+    );
+    delete markers;
+    // converting the supports to non-agreements on both slots of every edge
+    this->keys = new std::vector<na_key_t>(slots, NA_KEY_INVALID);
+    parallel_for(0ul, n, [&](unsigned long u) {
+        for(auto i = (*out_offsets)[u]; i < (*out_offsets)[u + 1]; ++i) {
+            auto slot_uv = (*out_slots)[i];
+            auto v = g->neighbor_at(slot_uv);
+            auto deg_u = g->deg_positive(u);
+            auto deg_v = g->deg_positive(v);
+            auto common = (*support)[slot_uv].load(std::memory_order_relaxed);
+            auto key = non_agreement_key(deg_u, deg_v, common);
+            (*this->keys)[slot_uv] = key;
+            (*this->keys)[g->where_is_in_neigh_plus(v, u)] = key;
+        }
+    }, num_threads);
+    delete support;
+    delete out_slots;
+    delete out_offsets;
+}
+
+EdgeSupport::~EdgeSupport() {
+    delete this->keys;
+}
+
+double EdgeSupport::non_agreement(unsigned long u, unsigned long v) {
+    auto slot = this->g->where_is_in_neigh_plus(u, v);
+    if (slot >= this->keys->size())
+        return INVALID_NON_AGREEMENT;
+    return na_key_to_double((*this->keys)[slot]);
+}
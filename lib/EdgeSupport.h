@@ -0,0 +1,73 @@
+/**
+ * @file EdgeSupport.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Per-edge common neighbor counts and non-agreements in one triangle counting pass
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef EDGE_SUPPORT_H_
+#define EDGE_SUPPORT_H_
+
+#include <vector>
+#include "GraphCSR.h"
+
+/**
+ * @brief The table of NonAgreement(u,v) for every positive edge {u,v} of a
+ * CSR snapshot, indexed by the CSR slots of the edge.
+ * @details |N^+(u) \cap N^+(v)| is the number of triangles containing {u,v},
+ * so all of them are computed by a single forward triangle counting pass:
+ * every edge is oriented from its endpoint of lower (degree, id) rank to the
+ * other one, and for each vertex u the out-neighbors of u are marked in a
+ * per-thread marker array; then each triangle (u,v,w) is found exactly once
+ * by scanning the out-neighbors of every out-neighbor v of u, and it adds one
+ * to the support of its three edges. This replaces 2m independent set
+ * intersections (one per NAO entry) by streaming scans.
+ */
+class EdgeSupport {
+    protected:
+        GraphCSR *g;
+        ///< the snapshot, which should outlive this object
+        std::vector<na_key_t> *keys;
+        ///< the exact key of NonAgreement of the edge stored at each CSR slot, both
+        ///< slots of an edge hold the same value
+    public:
+        /**
+         * @brief Construct the edge support table of g
+         *
+         * @param g the CSR snapshot of graph G
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        EdgeSupport(GraphCSR *g, unsigned int num_threads = 0u);
+        /**
+         * @brief Destroy the Edge Support object
+         *
+         */
+        ~EdgeSupport();
+        /**
+         * @brief the non-agreement of the edge stored at a CSR slot
+         *
+         * @param slot a slot in [0, 2m)
+         * @return double NonAgreement(u, neighbor_at(slot)) for the owner u of slot
+         */
+        double non_agreement_at(unsigned long slot) { return na_key_to_double((*this->keys)[slot]); };
+        /**
+         * @brief the exact key of the non-agreement of the edge stored at a CSR slot
+         *
+         * @param slot a slot in [0, 2m)
+         * @return na_key_t the key of NonAgreement(u, neighbor_at(slot)) for the owner u of slot
+         */
+        na_key_t key_at(unsigned long slot) { return (*this->keys)[slot]; };
+        /**
+         * @brief returns NonAgreement(u,v), or INVALID_NON_AGREEMENT if
+         * {u,v} is not a positive edge
+         *
+         * @param u vertex id
+         * @param v vertex id
+         * @return double
+         */
+        double non_agreement(unsigned long u, unsigned long v);
+};
+
+#endif // EDGE_SUPPORT_H_
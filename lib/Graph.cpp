@@ -1,4 +1,10 @@
 #include "Graph.h"
+#include "Intersection.h"
+#include "EdgeListParser.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <cmath>
+#include <tuple>
 
 unsigned long Graph::deg_positive(unsigned long v) {
     auto neigh_v = this->positive_adjacency->at(v);
@@ -9,12 +15,16 @@ unsigned long Graph::deg_positive(unsigned long v) {
 }
 
 Graph::Graph() {
-    this->positive_adjacency = new std::unordered_map<unsigned long, std::vector<unsigned long>*>();
+    this->n = 0ul;
+    this->m = 0ul;
+    this->positive_adjacency = new std::unordered_map<unsigned long, std::vector<vertex_id_t>*>();
+    this->live = new LiveVertexSet();
 }
 
 Graph::~Graph() {
     for(auto pair: *(this->positive_adjacency))
         delete pair.second;
+    delete this->live;
 }
 
 double Graph::non_agreement(unsigned long u, unsigned long v) {
@@ -24,11 +34,8 @@ double Graph::non_agreement(unsigned long u, unsigned long v) {
             auto neigh_v = this->get_neighborhood(v);
             auto deg_u = neigh_u->size();
             auto deg_v = neigh_v->size();
-            std::vector<unsigned long> neigh_intersect((deg_u > deg_v) ? deg_u : deg_v);
-            auto it = std::set_intersection(neigh_u->begin(), neigh_u->end(), 
-                neigh_v->begin(), neigh_v->end(), neigh_intersect.begin());
-            neigh_intersect.resize(it - neigh_intersect.begin());
-            return static_cast<double>(deg_u + deg_v - 2 * neigh_intersect.size())
+            auto common = intersection_count(neigh_u->data(), deg_u, neigh_v->data(), deg_v);
+            return static_cast<double>(deg_u + deg_v - 2 * common)
                 /(((deg_u > deg_v) ? deg_u : deg_v) + 1);
         } else {
             return INVALID_NON_AGREEMENT;
@@ -40,6 +47,15 @@ double Graph::non_agreement(unsigned long u, unsigned long v) {
     }
 }
 
+na_key_t Graph::non_agreement_key(unsigned long u, unsigned long v) {
+    if (! this->is_in_neigh_plus(v, u))
+        return NA_KEY_INVALID;
+    auto neigh_u = this->get_neighborhood(u);
+    auto neigh_v = this->get_neighborhood(v);
+    auto common = intersection_count(neigh_u->data(), neigh_u->size(), neigh_v->data(), neigh_v->size());
+    return ::non_agreement_key(neigh_u->size(), neigh_v->size(), common);
+}
+
 void Graph::add_positive_edge(unsigned long u, unsigned long v) {
     if (!this->is_in_neigh_plus(v, u) && u != v) {
         auto * neigh_v = this->positive_adjacency->at(v);
@@ -109,7 +125,7 @@ bool Graph::is_in_neigh_plus(unsigned long v, unsigned long query_vertex) {
     }
 }
 
-void Graph::add_to_sorted_vector(std::vector<unsigned long> * vect, unsigned long u) {
+void Graph::add_to_sorted_vector(std::vector<vertex_id_t> * vect, unsigned long u) {
     try {
         vect->insert(std::upper_bound(vect->begin(), vect->end(), u), u);
     }
@@ -119,59 +135,162 @@ void Graph::add_to_sorted_vector(std::vector<unsigned long> * vect, unsigned lon
     }
 }
 
-void Graph::load_from_file(std::string input) {
+void Graph::load_from_adjacency(unsigned long n, const unsigned long *offsets, const vertex_id_t *neighbors) {
+    check_vertex_id_bound(n);
+    for(auto pair: *(this->positive_adjacency))
+        delete pair.second;
+    this->positive_adjacency->clear();
+    this->positive_adjacency->reserve(n);
+    for(unsigned long v = 0ul; v < n; ++v) {
+        if (offsets[v] > offsets[v + 1])
+            throw std::invalid_argument("The offsets of the adjacency decrease at vertex " + std::to_string(v));
+        auto neigh_v = new std::vector<vertex_id_t>(neighbors + offsets[v], neighbors + offsets[v + 1]);
+        this->positive_adjacency->insert(std::make_pair(v, neigh_v));
+        for(auto u: *neigh_v) {
+            if (u >= n)
+                throw std::out_of_range("Edge {" + std::to_string(v) + ", " + std::to_string(u)
+                    + "} is out of range for n = " + std::to_string(n));
+        }
+    }
+    delete this->live;
+    this->live = new LiveVertexSet(n);
+    this->n = n;
+    this->m = offsets[n] / 2;
+}
+
+void Graph::load_from_file(std::string input, unsigned int num_threads) {
     // #_of_vertices #_of_edges
     // u_index v_index
-    auto failed = false;
+    PhaseTimer timer(PHASE_LOAD);
     try {
-        unsigned long n = 0, m = 0;
-        std::ifstream input_file(input, std::ios::in);
-        // BOOST_LOG_TRIVIAL(info) << "Open file: " << input;
-        if (input_file.is_open()) {
-            input_file >> n >> m;
-            // BOOST_LOG_TRIVIAL(info) << "vertices: " << n << ", edges: " << m;
-            for(unsigned long i = 0u; i < n; ++i) {
-                this->positive_adjacency->insert(std::make_pair(i, new std::vector<unsigned long>()));
-            }
-            unsigned long u = 0u, v = 0u;
-            unsigned long i = 0u;
-            while(! input_file.eof()) {
-                input_file >> u >> v;
-                // // BOOST_LOG_TRIVIAL(info) << "Going to add edge {" << u << "," << v << "}";
-                this->add_positive_edge(u, v);
-                ++i;
-            }
-            unsigned long sum = 0;
-            for(unsigned long i = 0; i < n; ++i) {
-                auto neigh = this->get_neighborhood(i);
-                assert(std::is_sorted(neigh->begin(), neigh->end()));
-                sum += neigh->size();
-            }
-            assert(sum % 2 == 0);
-            // BOOST_LOG_TRIVIAL(info) << "read: " << i << " edges (latest was " << u << "," << v << ")";
-            assert(i - 1 == m);
-            this->n = n;
-            if (sum / 2 != m)
-                // BOOST_LOG_TRIVIAL(info) << "Possible duplicate edges in the input file (" << i - 1 << " lines of edges read, " << sum / 2 << " edges added" << ")";
-            this->m = sum / 2;
+        auto parser = new EdgeListParser(input, num_threads);
+        try {
+            this->load_from_edges(parser->get_n(), parser->get_edges(), num_threads);
+        }
+        catch (std::exception &e) {
+            delete parser;
+            throw;
         }
-        else
-            failed = true;
-        input_file.close();
+        // BOOST_LOG_TRIVIAL(info) << "Parsed " << parser->get_bytes() << " bytes at " << parser->get_throughput() << " MB/s";
+        delete parser;
     }
     catch (std::exception &e) {
         BOOST_LOG_TRIVIAL(fatal) << "Error in reading the file: " << input << ": " << e.what();
         throw;
     }
-    if (failed)
-        throw std::invalid_argument("File error: " + input);
+}
+
+void Graph::load_from_edges(unsigned long n, const std::vector<std::pair<unsigned long, unsigned long>> *edges,
+    unsigned int num_threads)
+{
+    check_vertex_id_bound(n);
+    auto degrees = new std::vector<unsigned long>(n, 0ul);
+    for(auto e: *edges) {
+        if (e.first >= n || e.second >= n) {
+            delete degrees;
+            throw std::out_of_range("Edge {" + std::to_string(e.first) + ", "
+                + std::to_string(e.second) + "} is out of range for n = " + std::to_string(n));
+        }
+        if (e.first != e.second) {
+            (*degrees)[e.first]++;
+            (*degrees)[e.second]++;
+        }
+    }
+    for(auto pair: *(this->positive_adjacency))
+        delete pair.second;
+    this->positive_adjacency->clear();
+    this->positive_adjacency->reserve(n);
+    auto neighborhoods = new std::vector<std::vector<vertex_id_t>*>(n);
+    for(unsigned long v = 0ul; v < n; ++v) {
+        (*neighborhoods)[v] = new std::vector<vertex_id_t>();
+        (*neighborhoods)[v]->reserve((*degrees)[v]);
+    }
+    for(auto e: *edges) {
+        if (e.first != e.second) {
+            (*neighborhoods)[e.first]->push_back(e.second);
+            (*neighborhoods)[e.second]->push_back(e.first);
+        }
+    }
+    // sorting every neighborhood and dropping the duplicate edges
+    parallel_for_weighted(n,
+        [&](unsigned long v) {
+            double deg = (*degrees)[v];
+            return deg * std::log2(deg + 2.0) + 1.0;
+        },
+        [&](unsigned long v) {
+            auto neigh = (*neighborhoods)[v];
+            std::sort(neigh->begin(), neigh->end());
+            neigh->erase(std::unique(neigh->begin(), neigh->end()), neigh->end());
+        }, num_threads
+    );
+    unsigned long sum = 0ul;
+    for(unsigned long v = 0ul; v < n; ++v) {
+        sum += (*neighborhoods)[v]->size();
+        this->positive_adjacency->insert(std::make_pair(v, (*neighborhoods)[v]));
+    }
+    assert(sum % 2 == 0);
+    delete this->live;
+    this->live = new LiveVertexSet(n);
+    this->n = n;
+    this->m = sum / 2;
+    delete neighborhoods;
+    delete degrees;
+}
+
+void Graph::apply_edge_changes(const std::vector<std::pair<unsigned long, unsigned long>> *added,
+    const std::vector<std::pair<unsigned long, unsigned long>> *removed, unsigned int num_threads)
+{
+    // (vertex, neighbor, is_added) for both directions of every change, grouped by vertex
+    auto arcs = new std::vector<std::tuple<unsigned long, unsigned long, bool>>();
+    arcs->reserve(2 * (added->size() + removed->size()));
+    for(auto e: *added) {
+        arcs->push_back(std::make_tuple(e.first, e.second, true));
+        arcs->push_back(std::make_tuple(e.second, e.first, true));
+    }
+    for(auto e: *removed) {
+        arcs->push_back(std::make_tuple(e.first, e.second, false));
+        arcs->push_back(std::make_tuple(e.second, e.first, false));
+    }
+    std::sort(arcs->begin(), arcs->end());
+    auto group_starts = new std::vector<unsigned long>();
+    for(unsigned long i = 0ul; i < arcs->size(); ++i) {
+        if (i == 0ul || std::get<0>((*arcs)[i]) != std::get<0>((*arcs)[i - 1]))
+            group_starts->push_back(i);
+    }
+    group_starts->push_back(arcs->size());
+    parallel_for(0ul, group_starts->size() - 1, [&](unsigned long k) {
+        auto x = std::get<0>((*arcs)[(*group_starts)[k]]);
+        auto neigh_x = this->positive_adjacency->at(x);
+        auto merged = new std::vector<vertex_id_t>();
+        merged->reserve(neigh_x->size() + (*group_starts)[k + 1] - (*group_starts)[k]);
+        // the changes of x are sorted by neighbor, like N^+(x)
+        auto it = neigh_x->begin();
+        for(auto i = (*group_starts)[k]; i < (*group_starts)[k + 1]; ++i) {
+            auto w = std::get<1>((*arcs)[i]);
+            while (it != neigh_x->end() && *it < w)
+                merged->push_back(*it++);
+            if (std::get<2>((*arcs)[i]))
+                merged->push_back(w);
+            else if (it != neigh_x->end() && *it == w)
+                ++it;
+        }
+        merged->insert(merged->end(), it, neigh_x->end());
+        neigh_x->swap(*merged);
+        delete merged;
+    }, num_threads);
+    this->m += added->size();
+    this->m -= removed->size();
+    delete group_starts;
+    delete arcs;
 }
 
 unsigned long Graph::add_vertex() {
     try {
         auto new_id = this->positive_adjacency->size();
+        check_vertex_id_bound(new_id + 1);
         assert(this->positive_adjacency->find(new_id) == this->positive_adjacency->end());
-        this->positive_adjacency->insert(std::make_pair(new_id, new std::vector<unsigned long>()));
+        this->positive_adjacency->insert(std::make_pair(new_id, new std::vector<vertex_id_t>()));
+        this->live->add();
         this->n++;
         return new_id;
     }
@@ -185,11 +304,14 @@ void Graph::remove_vertex(unsigned long v) {
     try {
         auto neigh_v = this->get_neighborhood(v);
         if (neigh_v != nullptr) {
-            for(auto u: *neigh_v) {
+            std::vector<vertex_id_t> neighbors(*neigh_v);
+            //< copying, since removing the edges modifies neigh_v
+            for(auto u: neighbors) {
                 this->remove_positive_edge(u, v);
             }
             delete this->positive_adjacency->at(v);
             this->positive_adjacency->at(v) = nullptr;
+            this->live->remove(v);
             this->n--;
         }
         // else, it is already removed
@@ -200,13 +322,32 @@ void Graph::remove_vertex(unsigned long v) {
     }
 }
 
+std::vector<unsigned long>* Graph::compact_ids() {
+    auto old_to_new = this->live->compaction_map();
+    auto compacted = new std::unordered_map<unsigned long, std::vector<vertex_id_t>*>();
+    compacted->reserve(this->n);
+    this->live->for_each([&](unsigned long v) {
+        auto neigh_v = this->positive_adjacency->at(v);
+        for(auto &u: *neigh_v)
+            u = (*old_to_new)[u];
+        compacted->insert(std::make_pair((*old_to_new)[v], neigh_v));
+    });
+    //< the removed vertices have no adjacency list to free
+    delete this->positive_adjacency;
+    this->positive_adjacency = compacted;
+    delete this->live;
+    this->live = new LiveVertexSet(this->n);
+    return old_to_new;
+}
+
 Graph::Graph(const Graph* g) {
     this->m = g->m;
     this->n = g->n;
-    this->positive_adjacency = new std::unordered_map<unsigned long, std::vector<unsigned long>*>();
+    this->live = new LiveVertexSet(g->live);
+    this->positive_adjacency = new std::unordered_map<unsigned long, std::vector<vertex_id_t>*>();
     for(auto pa: *(g->positive_adjacency)) {
         this->positive_adjacency->insert(
-            std::make_pair(pa.first, new std::vector<unsigned long>(*(pa.second)))
+            std::make_pair(pa.first, (pa.second) ? new std::vector<vertex_id_t>(*(pa.second)) : nullptr)
         );
     }
 }
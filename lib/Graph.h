@@ -27,6 +27,9 @@
 // #include <boost/log/utility/setup/file.hpp>
 // #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/trivial.hpp>
+#include "NonAgreement.h"
+#include "VertexId.h"
+#include "LiveVertexSet.h"
 
 // #ifndef _INIT_LOGGER
 // #define _INIT_LOGGER 1
@@ -50,18 +53,22 @@ const double INVALID_NON_AGREEMENT = 5.0;
  * @brief This class implements the complete signed graph representation
  * which would be useful for dynamic operations as well as hierarchical 
  * correlation clustering.
- * @details Note that the vertices start as 0 and are of type unsigned long
+ * @details Note that the vertices start as 0 and are of type unsigned long,
+ * while the adjacency lists store them as vertex_id_t, see VertexId.h;
  * a vertex which is deleted would be marked by making its adjacency list equal 
  * to nullptr.
  * @note Any vertex id is unique and after removing a vertex, its id would not be
- * assigned to any other vertex.
+ * assigned to any other vertex, until compact_ids renumbers the live vertices.
  */
 class Graph {
     protected:
-        std::unordered_map<unsigned long, std::vector<unsigned long>*> * positive_adjacency;
+        std::unordered_map<unsigned long, std::vector<vertex_id_t>*> * positive_adjacency;
         ///< @brief Stores the adjacency list of each vertex in a pair of vertex id and
         ///< its adjacent vertices which are guaranteed to be sorted according to their id.
 
+        LiveVertexSet *live;
+        ///< @brief The vertex ids which are not removed
+
         unsigned long n; 
         ///< @brief The number of vertices
 
@@ -74,7 +81,7 @@ class Graph {
          * @param vect a sorted vector we want to add
          * @param v the vertex we want to add to vect
          */
-        void add_to_sorted_vector(std::vector<unsigned long> * vect, unsigned long v);
+        void add_to_sorted_vector(std::vector<vertex_id_t> * vect, unsigned long v);
     public:
         /**
          * @brief Construct a new Graph object
@@ -109,12 +116,34 @@ class Graph {
          * @return double either NonAgreement(u,v) or INVALID_NON_AGREEMENT
          */
         double non_agreement(unsigned long u, unsigned long v);
+        /**
+         * @brief computes the exact key of NonAgreement(u,v), see na_key
+         * 
+         * @param u vertex id
+         * @param v vertex id
+         * @return na_key_t the key, or NA_KEY_INVALID if {u,v} is not a positive edge
+         */
+        na_key_t non_agreement_key(unsigned long u, unsigned long v);
         /**
          * @brief Returns the number of vertices in the graph G
          * 
          * @return unsigned long returns |V|
          */
         unsigned long get_n() { return this->n; };
+        /**
+         * @brief Returns one past the largest vertex id ever assigned, 
+         * including the removed vertices
+         * 
+         * @return unsigned long the size of the vertex id space
+         */
+        unsigned long get_id_bound() { return this->positive_adjacency->size(); };
+        /**
+         * @brief Returns the vertex ids which are not removed, which the
+         * per-vertex loops iterate over instead of [0, get_id_bound())
+         * 
+         * @return const LiveVertexSet* 
+         */
+        const LiveVertexSet * get_live_vertices() { return this->live; };
         /**
          * @brief Returns the number of positive signed edges
          * 
@@ -125,9 +154,9 @@ class Graph {
          * @brief Get the positive neighborhood of a vertex v (read-only)
          * 
          * @param v 
-         * @return const std::vector<unsigned long>* |N^+(v)|
+         * @return const std::vector<vertex_id_t>* |N^+(v)|
          */
-        const std::vector<unsigned long> * get_neighborhood(unsigned long v) { return this->positive_adjacency->at(v); };
+        const std::vector<vertex_id_t> * get_neighborhood(unsigned long v) { return this->positive_adjacency->at(v); };
         /**
          * @brief Adds a positive edge to G
          * 
@@ -153,13 +182,59 @@ class Graph {
          *      - the edges are undirected, so `1 2` means an edge between vertices
          *      with indices 1 and 2
          * 
+         *      - blank lines and lines starting with `#` are skipped, self-loops
+         *      and repeated edges are ignored
+         * The file is parsed in parallel by EdgeListParser.
+         * 
          * @see :preprocess.py
          * 
          * @param input exact address to the input file
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void load_from_file(std::string input, unsigned int num_threads = 0u);
+        /**
+         * @brief load the graph from an array of positive edges, replacing
+         * the current content; self-loops and repeated edges are ignored
+         * @throws std::out_of_range if an edge has an id not less than n
+         * @throws std::overflow_error if n ids do not fit in vertex_id_t
+         *
+         * @param n the number of vertices
+         * @param edges the positive edges {u,v}, in any order and direction
+         * @param num_threads number of threads, 0 means all hardware threads
          */
-        void load_from_file(std::string input);
+        void load_from_edges(unsigned long n, const std::vector<std::pair<unsigned long, unsigned long>> *edges,
+            unsigned int num_threads = 0u);
+        /**
+         * @brief load the graph from the arrays of a CSR layout, e.g. of a
+         * mapped binary graph file, replacing the current content
+         * @details The neighborhood of v is neighbors[offsets[v] .. offsets[v+1]),
+         * which should be sorted, free of duplicates and symmetric.
+         * @throws std::invalid_argument if the offsets decrease
+         * @throws std::out_of_range if a neighbor id is not less than n
+         * @throws std::overflow_error if n ids do not fit in vertex_id_t
+         *
+         * @param n the number of vertices
+         * @param offsets array of n + 1 offsets
+         * @param neighbors array of offsets[n] neighbor ids
+         */
+        void load_from_adjacency(unsigned long n, const unsigned long *offsets, const vertex_id_t *neighbors);
+        /**
+         * @brief adds and removes many positive edges at once, merging the
+         * changes of each neighborhood in one pass; the neighborhoods are
+         * processed in parallel
+         * @note every added edge should be absent and every removed edge
+         * present, with existing and distinct endpoints, and no edge should
+         * appear twice
+         * 
+         * @param added the positive edges to add
+         * @param removed the positive edges to remove
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void apply_edge_changes(const std::vector<std::pair<unsigned long, unsigned long>> *added,
+            const std::vector<std::pair<unsigned long, unsigned long>> *removed, unsigned int num_threads = 0u);
         /**
          * @brief adds a new vertex and returns its id
+         * @throws std::overflow_error if the id does not fit in vertex_id_t
          * 
          * @return unsigned long the id of the new vertex
          */
@@ -170,6 +245,15 @@ class Graph {
          * @param v vertex id to be removed
          */
         void remove_vertex(unsigned long v); 
+        /**
+         * @brief renumbers the live vertices densely, keeping their order, so
+         * the removed ids are dropped and the id space is get_n() again;
+         * the neighborhoods stay sorted since the renumbering is increasing
+         * 
+         * @return std::vector<unsigned long>* the new id of every former id,
+         * REMOVED_VERTEX_ID for the removed ones, owned by the caller
+         */
+        std::vector<unsigned long>* compact_ids();
         /**
          * @brief returns the index of todo
          * TODO:
@@ -0,0 +1,235 @@
+#include "GraphCSR.h"
+#include "Parallel.h"
+#include "Intersection.h"
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief 64-bit FNV-1a over the ids of an array, continuing from hash; the
+ * ids are hashed as 64-bit values whatever their width
+ *
+ * @param hash the hash of the preceding data
+ * @param data first id
+ * @param size number of ids
+ * @return std::uint64_t
+ */
+template<typename T>
+static std::uint64_t fnv1a(std::uint64_t hash, const T *data, unsigned long size) {
+    for(unsigned long i = 0ul; i < size; ++i) {
+        hash ^= static_cast<std::uint64_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static const std::uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ull;
+
+static_assert(sizeof(GraphCSRFileHeader) == 64, "the binary graph header should be 64 bytes");
+
+GraphCSR::GraphCSR(Graph *g) {
+    this->n = g->get_id_bound();
+    this->m = g->get_positive_m();
+    this->live = new LiveVertexSet(g->get_live_vertices());
+    this->offsets_storage = new std::vector<unsigned long>(this->n + 1, 0ul);
+    for(unsigned long v = 0ul; v < this->n; ++v) {
+        auto neigh_v = g->get_neighborhood(v);
+        (*this->offsets_storage)[v + 1] = (*this->offsets_storage)[v] + ((neigh_v) ? neigh_v->size() : 0ul);
+    }
+    this->neighbors_storage = new std::vector<vertex_id_t>(this->offsets_storage->back());
+    for(unsigned long v = 0ul; v < this->n; ++v) {
+        auto neigh_v = g->get_neighborhood(v);
+        if (neigh_v)
+            std::copy(neigh_v->begin(), neigh_v->end(), this->neighbors_storage->begin() + (*this->offsets_storage)[v]);
+    }
+    assert(this->neighbors_storage->size() == 2 * this->m);
+    this->offsets = this->offsets_storage->data();
+    this->neighbors = this->neighbors_storage->data();
+    this->mapped = nullptr;
+    this->mapped_size = 0ul;
+}
+
+GraphCSR::GraphCSR(unsigned long n, const std::vector<std::pair<unsigned long, unsigned long>> *edges,
+    unsigned int num_threads)
+{
+    check_vertex_id_bound(n);
+    this->n = n;
+    // symmetrizing the edges into arcs, dropping the self-loops
+    auto arcs = new std::vector<std::pair<unsigned long, unsigned long>>();
+    arcs->reserve(2 * edges->size());
+    for(auto e: *edges) {
+        if (e.first == e.second)
+            continue;
+        if (e.first >= n || e.second >= n)
+            throw std::invalid_argument("Edge {" + std::to_string(e.first) + ", "
+                + std::to_string(e.second) + "} is out of range for n = " + std::to_string(n));
+        arcs->push_back(e);
+        arcs->push_back(std::make_pair(e.second, e.first));
+    }
+    parallel_sort(arcs->begin(), arcs->end(),
+        [](const std::pair<unsigned long, unsigned long> &a, const std::pair<unsigned long, unsigned long> &b) {
+            return a < b;
+        }, num_threads
+    );
+    arcs->erase(std::unique(arcs->begin(), arcs->end()), arcs->end());
+    this->m = arcs->size() / 2;
+    this->live = new LiveVertexSet(n);
+    this->offsets_storage = new std::vector<unsigned long>(this->n + 1, 0ul);
+    this->neighbors_storage = new std::vector<vertex_id_t>(arcs->size());
+    for(auto a: *arcs)
+        (*this->offsets_storage)[a.first + 1]++;
+    for(unsigned long v = 0ul; v < this->n; ++v)
+        (*this->offsets_storage)[v + 1] += (*this->offsets_storage)[v];
+    parallel_for(0ul, arcs->size(), [&](unsigned long i) {
+        (*this->neighbors_storage)[i] = (*arcs)[i].second;
+    }, num_threads);
+    delete arcs;
+    this->offsets = this->offsets_storage->data();
+    this->neighbors = this->neighbors_storage->data();
+    this->mapped = nullptr;
+    this->mapped_size = 0ul;
+}
+
+GraphCSR::GraphCSR(std::string input, bool verify_checksum) {
+    this->offsets_storage = nullptr;
+    this->neighbors_storage = nullptr;
+    this->live = nullptr;
+    auto fd = open(input.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open the binary graph file " + input);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(GraphCSRFileHeader)) {
+        close(fd);
+        throw std::runtime_error("The binary graph file " + input + " is truncated");
+    }
+    this->mapped_size = file_stat.st_size;
+    this->mapped = mmap(nullptr, this->mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file open
+    if (this->mapped == MAP_FAILED) {
+        this->mapped = nullptr;
+        throw std::runtime_error("Cannot map the binary graph file " + input);
+    }
+    auto header = static_cast<const GraphCSRFileHeader*>(this->mapped);
+    std::string problem;
+    if (std::memcmp(header->magic, GRAPH_CSR_MAGIC, sizeof(GRAPH_CSR_MAGIC)) != 0)
+        problem = "is not a binary graph file";
+    else if (header->version != GRAPH_CSR_VERSION)
+        problem = "has version " + std::to_string(header->version)
+            + ", expected " + std::to_string(GRAPH_CSR_VERSION);
+    else if (header->byte_order != GRAPH_CSR_BYTE_ORDER)
+        problem = "was written on a machine of a different byte order";
+    else if (header->id_bytes != sizeof(vertex_id_t))
+        problem = "has " + std::to_string(header->id_bytes) + "-byte ids, expected "
+            + std::to_string(sizeof(vertex_id_t));
+    else if (this->mapped_size != sizeof(GraphCSRFileHeader)
+        + (header->n + 1) * sizeof(unsigned long) + 2 * header->m * sizeof(vertex_id_t))
+        problem = "does not match the size given in its header";
+    if (problem.empty()) {
+        this->n = header->n;
+        this->m = header->m;
+        this->live = new LiveVertexSet(this->n);
+        this->offsets = reinterpret_cast<const unsigned long*>(
+            static_cast<const char*>(this->mapped) + sizeof(GraphCSRFileHeader));
+        this->neighbors = reinterpret_cast<const vertex_id_t*>(this->offsets + this->n + 1);
+        if (this->offsets[0] != 0ul || this->offsets[this->n] != 2 * this->m)
+            problem = "has inconsistent offsets";
+        for(unsigned long v = 0ul; problem.empty() && v < this->n; ++v) {
+            // so every neighborhood is a range inside the neighbors array
+            if (this->offsets[v] > this->offsets[v + 1])
+                problem = "has decreasing offsets at vertex " + std::to_string(v);
+        }
+        if (problem.empty() && verify_checksum) {
+            if (header->checksum != 0ull) {
+                auto hash = fnv1a(FNV1A_OFFSET_BASIS, this->offsets, this->n + 1);
+                hash = fnv1a(hash, this->neighbors, 2 * this->m);
+                if (hash != header->checksum)
+                    problem = "fails the checksum";
+            }
+            for(unsigned long slot = 0ul; problem.empty() && slot < 2 * this->m; ++slot) {
+                if (this->neighbors[slot] >= this->n)
+                    problem = "has neighbor id " + std::to_string(this->neighbors[slot]) + " out of range";
+            }
+        }
+    }
+    if (!problem.empty()) {
+        munmap(this->mapped, this->mapped_size);
+        this->mapped = nullptr;
+        delete this->live;
+        throw std::runtime_error("The binary graph file " + input + " " + problem);
+    }
+}
+
+GraphCSR::~GraphCSR() {
+    delete this->offsets_storage;
+    delete this->neighbors_storage;
+    delete this->live;
+    if (this->mapped)
+        munmap(this->mapped, this->mapped_size);
+}
+
+void GraphCSR::save_to_binary_file(std::string output, bool with_checksum) {
+    GraphCSRFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, GRAPH_CSR_MAGIC, sizeof(GRAPH_CSR_MAGIC));
+    header.version = GRAPH_CSR_VERSION;
+    header.byte_order = GRAPH_CSR_BYTE_ORDER;
+    header.id_bytes = sizeof(vertex_id_t);
+    header.n = this->n;
+    header.m = this->m;
+    if (with_checksum)
+        header.checksum = fnv1a(fnv1a(FNV1A_OFFSET_BASIS, this->offsets, this->n + 1),
+            this->neighbors, 2 * this->m);
+    std::ofstream output_file(output, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output_file.is_open())
+        throw std::runtime_error("Cannot open " + output + " for writing");
+    output_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output_file.write(reinterpret_cast<const char*>(this->offsets), (this->n + 1) * sizeof(unsigned long));
+    output_file.write(reinterpret_cast<const char*>(this->neighbors), 2 * this->m * sizeof(vertex_id_t));
+    output_file.close();
+    if (!output_file)
+        throw std::runtime_error("Failed to write the binary graph file " + output);
+}
+
+bool GraphCSR::is_binary_file(std::string input) {
+    char magic[sizeof(GRAPH_CSR_MAGIC)] = {0};
+    std::ifstream input_file(input, std::ios::in | std::ios::binary);
+    if (!input_file.read(magic, sizeof(magic)))
+        return false;
+    return std::memcmp(magic, GRAPH_CSR_MAGIC, sizeof(GRAPH_CSR_MAGIC)) == 0;
+}
+
+unsigned long GraphCSR::where_is_in_neigh_plus(unsigned long v, unsigned long query_vertex) {
+    auto begin = this->neighborhood_begin(v);
+    auto end = this->neighborhood_end(v);
+    auto lower = std::lower_bound(begin, end, query_vertex);
+    bool found = lower != end && *lower == query_vertex;
+    return found ? lower - this->neighbors : 2 * this->m;
+}
+
+bool GraphCSR::is_in_neigh_plus(unsigned long v, unsigned long query_vertex) {
+    return std::binary_search(this->neighborhood_begin(v), this->neighborhood_end(v), query_vertex);
+}
+
+unsigned long GraphCSR::count_common_neighbors(unsigned long u, unsigned long v) {
+    return intersection_count(this->neighborhood_begin(u), this->deg_positive(u),
+        this->neighborhood_begin(v), this->deg_positive(v));
+}
+
+double GraphCSR::non_agreement(unsigned long u, unsigned long v) {
+    if (! this->is_in_neigh_plus(v, u))
+        return INVALID_NON_AGREEMENT;
+    auto deg_u = this->deg_positive(u);
+    auto deg_v = this->deg_positive(v);
+    auto common = this->count_common_neighbors(u, v);
+    return static_cast<double>(deg_u + deg_v - 2 * common)
+        /(((deg_u > deg_v) ? deg_u : deg_v) + 1);
+}
+
+na_key_t GraphCSR::non_agreement_key(unsigned long u, unsigned long v) {
+    if (! this->is_in_neigh_plus(v, u))
+        return NA_KEY_INVALID;
+    return ::non_agreement_key(this->deg_positive(u), this->deg_positive(v), this->count_common_neighbors(u, v));
+}
@@ -0,0 +1,268 @@
+/**
+ * @file GraphCSR.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Immutable, read-optimized snapshot of the positive edges in CSR layout
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef GRAPH_CSR_H_
+#define GRAPH_CSR_H_
+
+#include <vector>
+#include <utility>
+#include <string>
+#include <cstdint>
+#include "Graph.h"
+
+const char GRAPH_CSR_MAGIC[8] = {'H', 'C', 'C', 'C', 'S', 'R', '\0', '\0'};
+///< @note the first eight bytes of a binary graph file
+const std::uint32_t GRAPH_CSR_VERSION = 1u;
+///< @note the version of the binary graph format written by this build
+const std::uint32_t GRAPH_CSR_BYTE_ORDER = 0x01020304u;
+///< @note written in native byte order, so a file from a machine of the other endianness is detected
+
+/**
+ * @brief The fixed 64-byte header of a binary graph file.
+ * @details It is followed by the offsets array (n + 1 64-bit offsets) and
+ * then the neighbors array (2m ids of id_bytes bytes each, the size of
+ * vertex_id_t of the writer), both in native byte order, so the arrays can
+ * be used in place once the file is mapped.
+ * The checksum is the 64-bit FNV-1a hash of the two arrays, or 0 if it was
+ * not computed by the writer.
+ */
+struct GraphCSRFileHeader {
+    char magic[8];
+    ///< GRAPH_CSR_MAGIC
+    std::uint32_t version;
+    ///< GRAPH_CSR_VERSION
+    std::uint32_t byte_order;
+    ///< GRAPH_CSR_BYTE_ORDER
+    std::uint32_t id_bytes;
+    ///< the size of a vertex id in the neighbors array in bytes
+    std::uint32_t flags;
+    ///< reserved, 0
+    std::uint64_t n;
+    ///< the number of vertex ids
+    std::uint64_t m;
+    ///< the number of positive edges
+    std::uint64_t checksum;
+    ///< FNV-1a of offsets followed by neighbors, 0 = no checksum
+    std::uint64_t reserved[2];
+    ///< 0
+};
+
+/**
+ * @brief A compressed sparse row (CSR) snapshot of the positive edges of a
+ * complete signed graph.
+ * @details The neighborhood of vertex v is the sorted range
+ * neighbors[offsets[v] .. offsets[v+1]), so each lookup is two array reads
+ * instead of a hash lookup followed by a pointer chase. Every undirected edge
+ * {u,v} occupies two slots, one in each neighborhood; the slot index
+ * (see where_is_in_neigh_plus) can be used to attach per-edge data.
+ * @note Vertex ids are the same as in the Graph the snapshot is taken from;
+ * a deleted vertex is kept with an empty neighborhood and is not in the
+ * live vertices of the snapshot. The binary file only stores the
+ * neighborhoods, so all the vertices of a mapped snapshot are live.
+ * @note A snapshot can be saved in a binary file (see GraphCSRFileHeader) and
+ * opened again by mapping the file read-only, in which case the arrays are
+ * not copied and the pages are shared between all the processes using it.
+ */
+class GraphCSR {
+    protected:
+        const unsigned long *offsets;
+        ///< @brief offsets[v] is the first slot of N^+(v) in neighbors, of size n + 1
+
+        const vertex_id_t *neighbors;
+        ///< @brief concatenation of all the sorted positive neighborhoods, of size 2m
+
+        std::vector<unsigned long> *offsets_storage;
+        ///< @brief the memory behind offsets, nullptr if the snapshot is mapped from a file
+
+        std::vector<vertex_id_t> *neighbors_storage;
+        ///< @brief the memory behind neighbors, nullptr if the snapshot is mapped from a file
+
+        void *mapped;
+        ///< @brief the mapped binary file, nullptr if the arrays are in memory
+
+        std::size_t mapped_size;
+        ///< @brief the length of the mapping in bytes
+
+        LiveVertexSet *live;
+        ///< @brief the vertex ids which are not removed
+        unsigned long n;
+        ///< @brief The number of vertex ids
+
+        unsigned long m;
+        ///< @brief The number of positive edges
+    public:
+        /**
+         * @brief Construct a new CSR snapshot of the graph g
+         *
+         * @param g the source graph, whose neighborhoods are already sorted
+         */
+        GraphCSR(Graph *g);
+        /**
+         * @brief Construct a new CSR snapshot directly from an edge array
+         * @details The edges are symmetrized, sorted in parallel and
+         * deduplicated, and self-loops are dropped, so the input may contain
+         * both {u,v} and {v,u} as well as repeated edges.
+         *
+         * @throws std::overflow_error if n ids do not fit in vertex_id_t
+         *
+         * @param n the number of vertices, all ids in edges must be less than n
+         * @param edges the positive edges as pairs of vertex ids
+         * @param num_threads number of threads to use, 0 means all hardware threads
+         */
+        GraphCSR(unsigned long n, const std::vector<std::pair<unsigned long, unsigned long>> *edges,
+            unsigned int num_threads = 0u);
+        /**
+         * @brief Open a snapshot saved by save_to_binary_file by mapping it
+         * read-only, so only the offsets are read unless the file is verified
+         * @throws std::runtime_error if the file cannot be mapped, is not a
+         * valid binary graph file of this version, id width and byte order,
+         * or its offsets decrease or exceed 2m
+         *
+         * @param input exact address to the binary file
+         * @param verify_checksum if true, the stored checksum (if any) and the
+         * range of every neighbor id are checked, which reads the whole file
+         */
+        GraphCSR(std::string input, bool verify_checksum = false);
+        /**
+         * @brief Destroy the GraphCSR object
+         *
+         */
+        ~GraphCSR();
+        /**
+         * @brief save the snapshot in the binary graph format
+         * @throws std::runtime_error if the file cannot be written
+         *
+         * @param output exact address to the output file
+         * @param with_checksum if true, the checksum of the arrays is stored in the header
+         */
+        void save_to_binary_file(std::string output, bool with_checksum = true);
+        /**
+         * @brief true iff the file starts with GRAPH_CSR_MAGIC
+         *
+         * @param input exact address to the file
+         * @return true iff input looks like a binary graph file
+         */
+        static bool is_binary_file(std::string input);
+        /**
+         * @brief true iff the arrays are mapped from a binary file
+         *
+         * @return bool
+         */
+        bool is_mapped() { return this->mapped != nullptr; };
+        /**
+         * @brief the offsets array, of size n + 1
+         *
+         * @return const unsigned long*
+         */
+        const unsigned long * get_offsets() { return this->offsets; };
+        /**
+         * @brief the neighbors array, of size 2m
+         *
+         * @return const vertex_id_t*
+         */
+        const vertex_id_t * get_neighbors() { return this->neighbors; };
+        /**
+         * @brief Returns the number of vertex ids in the snapshot
+         *
+         * @return unsigned long |V|
+         */
+        unsigned long get_n() { return this->n; };
+        /**
+         * @brief Returns the vertex ids which are not removed
+         *
+         * @return const LiveVertexSet*
+         */
+        const LiveVertexSet * get_live_vertices() { return this->live; };
+        /**
+         * @brief Returns the number of positive signed edges
+         *
+         * @return unsigned long |E^+|
+         */
+        unsigned long get_positive_m() { return this->m; };
+        /**
+         * @brief returns the number of adjacent edges with positive sign
+         *
+         * @param v the query vertex
+         * @return unsigned long deg_{G^+}(v)
+         */
+        unsigned long deg_positive(unsigned long v) { return this->offsets[v + 1] - this->offsets[v]; };
+        /**
+         * @brief returns the slot of the first neighbor of v
+         *
+         * @param v vertex id
+         * @return unsigned long offsets[v]
+         */
+        unsigned long get_offset(unsigned long v) { return this->offsets[v]; };
+        /**
+         * @brief returns the vertex stored at a slot of the neighbor array
+         *
+         * @param slot slot index in [0, 2m)
+         * @return unsigned long the neighbor id
+         */
+        unsigned long neighbor_at(unsigned long slot) { return this->neighbors[slot]; };
+        /**
+         * @brief pointer to the first element of the sorted N^+(v)
+         *
+         * @param v vertex id
+         * @return const vertex_id_t*
+         */
+        const vertex_id_t * neighborhood_begin(unsigned long v) { return this->neighbors + this->offsets[v]; };
+        /**
+         * @brief pointer past the last element of the sorted N^+(v)
+         *
+         * @param v vertex id
+         * @return const vertex_id_t*
+         */
+        const vertex_id_t * neighborhood_end(unsigned long v) { return this->neighbors + this->offsets[v + 1]; };
+        /**
+         * @brief returns the slot of query_vertex inside N^+(v)
+         *
+         * @param v vertex id
+         * @param query_vertex query vertex id
+         * @return unsigned long the slot index, or 2m if query_vertex is not in N^+(v)
+         */
+        unsigned long where_is_in_neigh_plus(unsigned long v, unsigned long query_vertex);
+        /**
+         * @brief true iff query_vertex \in N_+[v]
+         *
+         * @param v vertex id
+         * @param query_vertex query vertex id
+         * @return true iff query_vertex \in N_+[v]
+         * @return false otherwise
+         */
+        bool is_in_neigh_plus(unsigned long v, unsigned long query_vertex);
+        /**
+         * @brief returns |N^+(u) \cap N^+(v)|
+         *
+         * @param u vertex id
+         * @param v vertex id
+         * @return unsigned long the number of common positive neighbors
+         */
+        unsigned long count_common_neighbors(unsigned long u, unsigned long v);
+        /**
+         * @brief computes and returns the \textsc{NonAgreement} of the two
+         * vertices u and v if they are adjacent by a positive edge. Otherwise,
+         * returns INVALID_NON_AGREEMENT
+         *
+         * @param u vertex id
+         * @param v vertex id
+         * @return double either NonAgreement(u,v) or INVALID_NON_AGREEMENT
+         */
+        double non_agreement(unsigned long u, unsigned long v);
+        /**
+         * @brief computes the exact key of NonAgreement(u,v), see na_key
+         *
+         * @param u vertex id
+         * @param v vertex id
+         * @return na_key_t the key, or NA_KEY_INVALID if {u,v} is not a positive edge
+         */
+        na_key_t non_agreement_key(unsigned long u, unsigned long v);
+};
+
+#endif // GRAPH_CSR_H_
@@ -0,0 +1,210 @@
+#include "HierarchicalCorrelationClustering.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+HierarchicalCorrelationClustering::HierarchicalCorrelationClustering(Graph *g, unsigned int num_threads) {
+    this->csr = new GraphCSR(g);
+    this->owns_csr = true;
+    this->num_threads = num_threads;
+    this->build_edge_order(num_threads);
+}
+
+HierarchicalCorrelationClustering::HierarchicalCorrelationClustering(GraphCSR *g, unsigned int num_threads) {
+    this->csr = g;
+    this->owns_csr = false;
+    this->num_threads = num_threads;
+    this->build_edge_order(num_threads);
+}
+
+HierarchicalCorrelationClustering::~HierarchicalCorrelationClustering() {
+    delete this->edge_key;
+    delete this->edge_v;
+    delete this->edge_u;
+    delete this->support;
+    if (this->owns_csr)
+        delete this->csr;
+}
+
+void HierarchicalCorrelationClustering::build_edge_order(unsigned int num_threads) {
+    PhaseTimer timer(PHASE_EDGE_ORDER);
+    this->rebuilds = 0ul;
+    this->support = new EdgeSupport(this->csr, num_threads);
+    auto edges = new std::vector<std::tuple<na_key_t, vertex_id_t, vertex_id_t>>();
+    edges->reserve(this->csr->get_positive_m());
+    this->csr->get_live_vertices()->for_each([this, edges](unsigned long u) {
+        for(auto slot = this->csr->get_offset(u); slot < this->csr->get_offset(u + 1); ++slot) {
+            auto v = this->csr->neighbor_at(slot);
+            if (v > u)
+                edges->emplace_back(this->support->key_at(slot), u, v);
+        }
+    });
+    // the edges are generated in (u, v) order and the radix sort is stable,
+    // so ties of the keys stay in (u, v) order
+    parallel_radix_sort(*edges,
+        [](const std::tuple<na_key_t, vertex_id_t, vertex_id_t> &e) { return std::get<0>(e); },
+        num_threads);
+    this->edge_u = new std::vector<vertex_id_t>(edges->size());
+    this->edge_v = new std::vector<vertex_id_t>(edges->size());
+    this->edge_key = new std::vector<na_key_t>(edges->size());
+    for(unsigned long i = 0ul; i < edges->size(); ++i) {
+        (*this->edge_key)[i] = std::get<0>((*edges)[i]);
+        (*this->edge_u)[i] = std::get<1>((*edges)[i]);
+        (*this->edge_v)[i] = std::get<2>((*edges)[i]);
+    }
+    delete edges;
+}
+
+void HierarchicalCorrelationClustering::unite_agreeing_neighbors(unsigned long v, na_key_t eps_key,
+    const std::vector<bool> *is_light, UnionFind *uf)
+{
+    for(auto slot = this->csr->get_offset(v); slot < this->csr->get_offset(v + 1); ++slot) {
+        auto w = this->csr->neighbor_at(slot);
+        if (this->support->key_at(slot) < eps_key && !((*is_light)[v] && (*is_light)[w]))
+            uf->unite(v, w);
+    }
+}
+
+std::vector<std::vector<unsigned long>*>* HierarchicalCorrelationClustering::query(const std::vector<double> &eps_schedule) {
+    PhaseTimer timer(PHASE_HIERARCHICAL_QUERY);
+    if (!std::is_sorted(eps_schedule.begin(), eps_schedule.end()))
+        throw std::invalid_argument("HierarchicalCorrelationClustering: eps schedule is not sorted");
+    auto n = this->csr->get_n();
+    auto assignments = new std::vector<std::vector<unsigned long>*>();
+    assignments->reserve(eps_schedule.size());
+    this->rebuilds = 0ul;
+    if (eps_schedule.empty())
+        return assignments;
+
+    auto eps_agree_cnt = new std::vector<vertex_id_t>(n, 0);
+    auto is_light = new std::vector<bool>(n, true);
+    auto touched_at = new std::vector<unsigned long>(n, 0ul);
+    //< touched_at[v] is 1 + the index of the last level in which v was a candidate to flip
+    auto candidates = new std::vector<vertex_id_t>();
+    auto became_light = new std::vector<vertex_id_t>();
+    auto became_heavy = new std::vector<vertex_id_t>();
+    // min-heap of (agree_cnt/deg, agree_cnt, v) for the heavy vertices,
+    // an entry is stale if the count of v has changed since it was pushed
+    typedef std::tuple<double, unsigned long, unsigned long> heavy_entry;
+    std::priority_queue<heavy_entry, std::vector<heavy_entry>, std::greater<heavy_entry>> heavy_heap;
+    UnionFind *uf = nullptr;
+    auto live = this->csr->get_live_vertices();
+    unsigned long light_vertices = live->size();
+    //< a removed vertex stays light and is never a candidate
+    unsigned long pos = 0ul;
+    //< the edges [0, pos) are the eps-agreement edges of the current level
+
+    for(unsigned long level = 0ul; level < eps_schedule.size(); ++level) {
+        auto eps = eps_schedule[level];
+        auto eps_key = eps_to_key(eps);
+        auto stamp = level + 1;
+        candidates->clear();
+        became_light->clear();
+        became_heavy->clear();
+        // advancing over the edges which enter the eps-agreement set
+        auto new_pos = static_cast<unsigned long>(
+            std::lower_bound(this->edge_key->begin() + pos, this->edge_key->end(), eps_key)
+            - this->edge_key->begin()
+        );
+        for(auto i = pos; i < new_pos; ++i) {
+            for(auto v : {(*this->edge_u)[i], (*this->edge_v)[i]}) {
+                (*eps_agree_cnt)[v]++;
+                if ((*touched_at)[v] != stamp) {
+                    (*touched_at)[v] = stamp;
+                    candidates->push_back(v);
+                }
+            }
+        }
+        if (level == 0ul) {
+            // the first level decides the status of every vertex
+            candidates->clear();
+            live->for_each([&](unsigned long v) {
+                (*touched_at)[v] = stamp;
+                candidates->push_back(v);
+            });
+        }
+        else {
+            // untouched heavy vertices turn light only when eps passes agree_cnt/deg
+            std::vector<heavy_entry> keep;
+            while (!heavy_heap.empty() && std::get<0>(heavy_heap.top()) <= eps) {
+                auto entry = heavy_heap.top();
+                heavy_heap.pop();
+                auto v = std::get<2>(entry);
+                if ((*is_light)[v] || std::get<1>(entry) != (*eps_agree_cnt)[v])
+                    continue; // stale
+                if ((*touched_at)[v] == stamp)
+                    continue; // already a candidate
+                if ((*eps_agree_cnt)[v] < eps * this->csr->deg_positive(v)) {
+                    (*touched_at)[v] = stamp;
+                    candidates->push_back(v);
+                }
+                else
+                    keep.push_back(entry); // rounding, still heavy
+            }
+            for(auto &entry : keep)
+                heavy_heap.push(entry);
+        }
+        for(auto v : *candidates) {
+            auto deg = this->csr->deg_positive(v);
+            bool light = (deg == 0) || (*eps_agree_cnt)[v] < eps * deg;
+            if (!light)
+                heavy_heap.push(heavy_entry(
+                    static_cast<double>((*eps_agree_cnt)[v]) / deg, (*eps_agree_cnt)[v], v));
+            if (light != (*is_light)[v]) {
+                (*is_light)[v] = light;
+                (light ? became_light : became_heavy)->push_back(v);
+            }
+        }
+        // a surviving edge is deleted only if one of its endpoints turned light
+        bool rebuild = (uf == nullptr);
+        for(unsigned long i = 0ul; !rebuild && i < became_light->size(); ++i) {
+            auto v = (*became_light)[i];
+            for(auto slot = this->csr->get_offset(v); slot < this->csr->get_offset(v + 1); ++slot) {
+                if (
+                    this->support->key_at(slot) < eps_key &&
+                    (*is_light)[this->csr->neighbor_at(slot)]
+                ) {
+                    rebuild = true;
+                    break;
+                }
+            }
+        }
+        if (rebuild) {
+            delete uf;
+            uf = new UnionFind(n, this->num_threads);
+            parallel_for(0ul, new_pos, [&](unsigned long i) {
+                auto u = (*this->edge_u)[i], v = (*this->edge_v)[i];
+                if (!((*is_light)[u] && (*is_light)[v]))
+                    uf->unite(u, v);
+            }, this->num_threads);
+            this->rebuilds++;
+        }
+        else {
+            for(auto i = pos; i < new_pos; ++i) {
+                auto u = (*this->edge_u)[i], v = (*this->edge_v)[i];
+                if (!((*is_light)[u] && (*is_light)[v]))
+                    uf->unite(u, v);
+            }
+            // light-light edges of the previous level which now have a heavy endpoint
+            for(auto v : *became_heavy)
+                this->unite_agreeing_neighbors(v, eps_key, is_light, uf);
+        }
+        light_vertices = light_vertices + became_light->size() - became_heavy->size();
+        stat_add(STAT_LIGHT_VERTICES, light_vertices);
+        stat_add(STAT_NAO_ENTRIES_SCANNED, new_pos - pos);
+        pos = new_pos;
+        assignments->push_back(uf->labels(this->num_threads));
+    }
+    delete uf;
+    delete became_heavy;
+    delete became_light;
+    delete candidates;
+    delete touched_at;
+    delete is_light;
+    delete eps_agree_cnt;
+    return assignments;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file HierarchicalCorrelationClustering.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Hierarchical Correlation Clustering over an eps schedule in a single sweep
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef HIERARCHICAL_CORRELATION_CLUSTERING_H_
+#define HIERARCHICAL_CORRELATION_CLUSTERING_H_
+
+#include <vector>
+#include "Graph.h"
+#include "GraphCSR.h"
+#include "EdgeSupport.h"
+#include "UnionFind.h"
+
+/**
+ * @brief Computes the correlation clustering for every eps of a sorted
+ * schedule in one pass over the edges sorted by their non-agreement.
+ * @details The set of eps-agreement edges only grows with eps, so moving
+ * from one level to the next advances a pointer over the sorted edges and
+ * updates the eps-agreement counts of their endpoints. A vertex may change
+ * its eps-light status only if its count changes or eps passes the ratio
+ * count/deg, which is tracked by a min-heap over the heavy vertices. The
+ * union-find of the surviving edges is carried to the next level and only
+ * the new edges, plus the edges of vertices which became heavy, are united;
+ * it is rebuilt from the agreement prefix only when a vertex becoming
+ * light really deletes an edge.
+ */
+class HierarchicalCorrelationClustering {
+    protected:
+        GraphCSR *csr;
+        ///< the snapshot of the input graph
+        bool owns_csr;
+        ///< true iff csr is built (and should be freed) by this object
+        EdgeSupport *support;
+        ///< the non-agreement of every edge
+        std::vector<vertex_id_t> *edge_u;
+        ///< the smaller endpoint of each edge, in increasing order of non-agreement
+        std::vector<vertex_id_t> *edge_v;
+        ///< the larger endpoint of each edge, in increasing order of non-agreement
+        std::vector<na_key_t> *edge_key;
+        ///< the exact non-agreement key of each edge, sorted
+        unsigned long rebuilds;
+        ///< the number of levels of the last query whose union-find was rebuilt
+        unsigned int num_threads;
+        ///< number of threads, 0 means all hardware threads
+        /**
+         * @brief sorts all the edges of the snapshot by their non-agreement
+         *
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void build_edge_order(unsigned int num_threads);
+        /**
+         * @brief unites v with all its eps-agreement neighbors which are not
+         * both light with v
+         *
+         * @param v vertex id
+         * @param eps_key the threshold key of eps, see eps_to_key
+         * @param is_light the current eps-light flags
+         * @param uf the union-find of the surviving edges
+         */
+        void unite_agreeing_neighbors(unsigned long v, na_key_t eps_key,
+            const std::vector<bool> *is_light, UnionFind *uf);
+    public:
+        /**
+         * @brief Construct a new Hierarchical Correlation Clustering object
+         *
+         * @param g input graph
+         * @param num_threads number of threads for the preprocessing and the queries, 0 means all hardware threads
+         */
+        HierarchicalCorrelationClustering(Graph *g, unsigned int num_threads = 0u);
+        /**
+         * @brief Construct a new Hierarchical Correlation Clustering object
+         * on a CSR snapshot
+         *
+         * @param g input graph snapshot, which should outlive this object
+         * @param num_threads number of threads for the preprocessing and the queries, 0 means all hardware threads
+         */
+        HierarchicalCorrelationClustering(GraphCSR *g, unsigned int num_threads = 0u);
+        /**
+         * @brief Destroy the Hierarchical Correlation Clustering object
+         *
+         */
+        ~HierarchicalCorrelationClustering();
+        /**
+         * @brief returns the clustering for every eps of the schedule
+         *
+         * @param eps_schedule a non-decreasing sequence of eps values
+         * @return std::vector<std::vector<unsigned long>*>* the cluster
+         * assignment (starting at 1) of each level, in the order of eps_schedule
+         */
+        std::vector<std::vector<unsigned long>*>* query(const std::vector<double> &eps_schedule);
+        /**
+         * @brief the number of levels of the last query for which the
+         * union-find had to be rebuilt from scratch
+         *
+         * @return unsigned long
+         */
+        unsigned long get_rebuilds() { return this->rebuilds; };
+};
+
+#endif // HIERARCHICAL_CORRELATION_CLUSTERING_H_
@@ -1,92 +1,367 @@
 #include "IndexBasedCorrelationClustering.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <tuple>
+#include <unordered_set>
 
-IndexBasedCorrelationClustering::IndexBasedCorrelationClustering(Graph *g) 
+IndexBasedCorrelationClustering::IndexBasedCorrelationClustering(Graph *g, unsigned int num_threads) 
     : NaiveCorrelationClustering(g) 
 {
-    auto n = this->g->get_n();
-    this->naos = new std::unordered_map<unsigned long, NAO*>();
-    for(unsigned long i = 0ul; i < n; ++i) {
-        this->naos->insert(std::make_pair(i, new NAO(i, this->g)));
-    }
+    this->num_threads = num_threads;
+    this->pending_dirty = new std::vector<unsigned long>();
+    this->build_naos();
+}
+
+IndexBasedCorrelationClustering::IndexBasedCorrelationClustering(GraphCSR *g, unsigned int num_threads) 
+    : NaiveCorrelationClustering(g) 
+{
+    this->num_threads = num_threads;
+    this->pending_dirty = new std::vector<unsigned long>();
+    this->build_naos();
+}
+
+void IndexBasedCorrelationClustering::build_naos() {
+    this->naos = new NAOArena(this->csr, this->num_threads);
+    this->edge_order = new EdgeOrder(this->naos, this->num_threads);
 }
 
 void IndexBasedCorrelationClustering::reset_naos() {
-    for(auto e: *(this->naos)) {
-        delete e.second;
-    }
+    delete this->edge_order;
     delete this->naos;
+    this->pending_dirty->clear();
     this->reset_g();
-    auto n = this->g->get_n();
-    this->naos = new std::unordered_map<unsigned long, NAO*>();
-    for(unsigned long i = 0ul; i < n; ++i) {
-        this->naos->insert(std::make_pair(i, new NAO(i, this->g)));
-    }
+    this->build_naos();
 }
 
 IndexBasedCorrelationClustering::~IndexBasedCorrelationClustering() {
-    for(auto e: *(this->naos)) {
-        delete e.second;
-    }
+    delete this->edge_order;
     delete this->naos;
+    delete this->pending_dirty;
 }
 
 std::vector<unsigned long>* IndexBasedCorrelationClustering::query(double eps) {
-    auto n = this->g->get_n();
-    // if (this->g_temp != nullptr)
-    //     delete this->g_temp;
-    // std::cerr << "HELLOEELELELELE*******************" << std::endl;
-    this->g_temp = new Graph(this->original_g);
-    this->remove_non_agree_edges_and_light_with_index(eps);
-    return this->connected_components();
-}
-
-
-void IndexBasedCorrelationClustering::remove_non_agree_edges_and_light_with_index(double eps) {
-    // identifying all edges which are in non-eps agreement
-    auto non_agree_edges = new std::vector<std::pair<unsigned long, unsigned long>>();
-    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
-        for(auto p: this->naos->at(i)->query(eps)) {
-            if (p.first > i)
-                non_agree_edges->push_back(std::make_pair(i, p.first));
-        }
-    }
+    PhaseTimer timer(PHASE_INDEX_QUERY);
+    this->repair_pending_naos();
+    auto uf = new UnionFind(this->get_id_bound(), this->num_threads);
+    this->unite_surviving_edges_with_index(eps, uf);
+    auto assignment = uf->labels(this->num_threads);
+    delete uf;
+    return assignment;
+}
+
+
+void IndexBasedCorrelationClustering::unite_surviving_edges_with_index(double eps, UnionFind *uf) {
     // identifying whether vertices are e-light or not
-    auto is_light = new std::vector<bool>(this->g->get_n(), false);
-    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
-        if (! this->naos->at(i)->is_heavy(eps))
-            (*is_light)[i] = true;
-    }
-    // removing all non-agree edges
-    for(auto edge: *non_agree_edges) {
-        this->g_temp->remove_positive_edge(edge.first, edge.second);
-    }
-    std::cerr << "Index: There are " << non_agree_edges->size() 
-        << " non-agree edges to delete." << std::endl;
-    // removing light vertices
-    delete non_agree_edges;
-    non_agree_edges = new std::vector<std::pair<unsigned long, unsigned long>>();
-    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
-        for(auto j: *(this->g->get_neighborhood(i))) {
-            if ((*is_light)[i] && (*is_light)[j]) {
-                non_agree_edges->push_back(std::make_pair(i,j));
-            }
+    auto n = this->get_id_bound();
+    auto is_light = new std::vector<bool>(n, true);
+    //< a removed vertex has no NAO and stays light
+    auto threshold = to_nao_threshold(eps_to_key(eps));
+    std::vector<unsigned char> heavy;
+    this->naos->refresh_heavy_intervals(this->num_threads);
+    this->naos->classify_heavy(eps, &heavy);
+    //< from the precomputed heavy intervals, without reading the NAOs
+    unsigned long heavy_vertices = 0ul;
+    for(unsigned long i = 0ul; i < heavy.size(); ++i) {
+        if (heavy[i]) {
+            (*is_light)[i] = false;
+            heavy_vertices++;
         }
     }
-    for(auto edge: *non_agree_edges) {
-        this->g_temp->remove_positive_edge(edge.first, edge.second);
+    stat_add(STAT_LIGHT_VERTICES, this->naos->get_live_vertices()->size() - heavy_vertices);
+    // keeping the e-agreement edges which are not between two light vertices
+    if (this->edge_order->is_worth_rebuilding())
+        this->edge_order->rebuild(this->num_threads);
+    auto threads = resolve_num_threads(this->num_threads);
+    std::vector<unsigned long> agree_edges_of(threads, 0ul), light_edges_of(threads, 0ul);
+    //< per thread
+    this->edge_order->for_each_agreeing(threshold, [&](unsigned long i, unsigned long j, unsigned int t) {
+        agree_edges_of[t]++;
+        if ((*is_light)[i] && (*is_light)[j])
+            light_edges_of[t]++;
+        else
+            uf->unite(i, j);
+    }, threads);
+    unsigned long agree_edges = 0ul, light_edges = 0ul;
+    for(unsigned long t = 0ul; t < threads; ++t) {
+        agree_edges += agree_edges_of[t];
+        light_edges += light_edges_of[t];
     }
-    std::cerr << "Index: There are " << non_agree_edges->size() 
-        << " light edges to delete." << std::endl;
+    auto m = (this->g) ? this->g->get_positive_m() : this->csr->get_positive_m();
+    stat_add(STAT_EDGES_PRUNED, m - agree_edges + light_edges);
     delete is_light;
-    delete non_agree_edges;
 }
 
 std::map<double, unsigned long>* IndexBasedCorrelationClustering::get_all_eps() {
+    this->repair_pending_naos();
+    // the keys are deduplicated as integers, so two entries are counted
+    // together iff their non-agreements are the same fraction
+    std::vector<nao_key_t> all_keys;
+    this->naos->get_live_vertices()->for_each([this, &all_keys](unsigned long i) {
+        all_keys.insert(all_keys.end(), this->naos->keys_of(i), this->naos->keys_of(i) + this->naos->size(i));
+    });
+    parallel_radix_sort(all_keys, [](nao_key_t key) { return static_cast<na_key_t>(key); }, this->num_threads);
     auto output = new std::map<double, unsigned long>();
-    for(auto nao: *(this->naos)) {
-        for(auto el: *(nao.second->get_nao())) {
-            (*output)[el.second]++;
-        }
+    for(unsigned long k = 0ul; k < all_keys.size(); ) {
+        auto run_end = k;
+        while (run_end < all_keys.size() && all_keys[run_end] == all_keys[k])
+            ++run_end;
+        (*output)[na_key_to_double(static_cast<na_key_t>(all_keys[k]) << NAO_KEY_SHIFT)] += run_end - k;
+        k = run_end;
     }
     return output;
 }
+
+std::unique_ptr<NAO> IndexBasedCorrelationClustering::get_nao(unsigned long v) {
+    this->repair_pending_naos();
+    if (!this->naos->has(v))
+        throw std::out_of_range("There is no NAO for vertex " + std::to_string(v) + ".");
+    return std::unique_ptr<NAO>(new NAO(v, this->naos->entries(v)));
+}
+
+void IndexBasedCorrelationClustering::ensure_dynamic() {
+    if (this->g == nullptr)
+        throw std::logic_error("Updates are not supported on a CSR snapshot.");
+}
+
+void IndexBasedCorrelationClustering::repair_naos_around(const std::vector<unsigned long> &touched) {
+    std::vector<unsigned long> sorted_touched(touched);
+    std::sort(sorted_touched.begin(), sorted_touched.end());
+    for(auto x: touched) {
+        auto neigh_x = this->g->get_neighborhood(x);
+        if (neigh_x == nullptr)
+            continue; // x is removed
+        for(auto w: *neigh_x) {
+            // an edge between two touched vertices is repaired once, from its smaller endpoint
+            if (w < x && std::binary_search(sorted_touched.begin(), sorted_touched.end(), w))
+                continue;
+            auto na = this->g->non_agreement_key(x, w);
+            this->naos->insert(x, w, na);
+            this->naos->insert(w, x, na);
+        }
+    }
+}
+
+void IndexBasedCorrelationClustering::add_edge(unsigned long u, unsigned long v) {
+    PhaseTimer timer(PHASE_UPDATE);
+    this->ensure_dynamic();
+    this->repair_pending_naos();
+    this->g->deg_positive(u); // throws if u is removed
+    this->g->deg_positive(v); // throws if v is removed
+    if (u == v || this->g->is_in_neigh_plus(u, v))
+        return;
+    this->g->add_positive_edge(u, v);
+    this->repair_naos_around({u, v});
+    stat_add(STAT_UPDATES_APPLIED);
+}
+
+void IndexBasedCorrelationClustering::remove_edge(unsigned long u, unsigned long v) {
+    PhaseTimer timer(PHASE_UPDATE);
+    this->ensure_dynamic();
+    this->repair_pending_naos();
+    this->g->deg_positive(u); // throws if u is removed
+    this->g->deg_positive(v); // throws if v is removed
+    if (! this->g->is_in_neigh_plus(u, v))
+        return;
+    this->g->remove_positive_edge(u, v);
+    this->naos->remove(u, v);
+    this->naos->remove(v, u);
+    this->repair_naos_around({u, v});
+    stat_add(STAT_UPDATES_APPLIED);
+}
+
+unsigned long IndexBasedCorrelationClustering::add_vertex() {
+    PhaseTimer timer(PHASE_UPDATE);
+    this->ensure_dynamic();
+    this->repair_pending_naos();
+    auto v = this->g->add_vertex();
+    while (this->naos->get_n() <= v)
+        this->naos->add_vertex();
+    stat_add(STAT_UPDATES_APPLIED);
+    return v;
+}
+
+void IndexBasedCorrelationClustering::remove_vertex(unsigned long v) {
+    PhaseTimer timer(PHASE_UPDATE);
+    this->ensure_dynamic();
+    this->repair_pending_naos();
+    auto neigh_v = this->g->get_neighborhood(v);
+    if (neigh_v == nullptr)
+        return; // it is already removed
+    std::vector<unsigned long> former_neighbors(neigh_v->begin(), neigh_v->end());
+    this->g->remove_vertex(v);
+    this->naos->remove_vertex(v);
+    for(auto w: former_neighbors)
+        this->naos->remove(w, v);
+    this->repair_naos_around(former_neighbors);
+    stat_add(STAT_UPDATES_APPLIED);
+}
+
+std::vector<unsigned long>* IndexBasedCorrelationClustering::compact_ids() {
+    PhaseTimer timer(PHASE_COMPACTION);
+    this->ensure_dynamic();
+    this->repair_pending_naos();
+    //< the NAOs should not have entries of removed vertices
+    auto old_to_new = this->g->compact_ids();
+    this->naos->compact_ids(old_to_new);
+    delete this->edge_order;
+    this->edge_order = new EdgeOrder(this->naos, this->num_threads);
+    if (this->owns_csr) {
+        // keeping the snapshot in the same id space as g
+        delete this->csr;
+        this->csr = new GraphCSR(this->g);
+    }
+    return old_to_new;
+}
+
+void IndexBasedCorrelationClustering::apply_batch(const std::vector<Update> *updates, bool defer_repair) {
+    PhaseTimer timer(PHASE_UPDATE);
+    this->ensure_dynamic();
+    // validating the batch against the vertices it adds and removes
+    auto id_bound = this->g->get_id_bound();
+    auto next_id = id_bound;
+    std::unordered_set<unsigned long> removed_in_batch;
+    auto exists = [&](unsigned long v) {
+        if (v >= next_id || removed_in_batch.count(v))
+            return false;
+        return v >= id_bound || this->g->get_neighborhood(v) != nullptr;
+    };
+    std::vector<std::tuple<unsigned long, unsigned long, unsigned long, bool>> edge_ops;
+    //< (min endpoint, max endpoint, position in the batch, is an insert)
+    for(unsigned long i = 0ul; i < updates->size(); ++i) {
+        auto &update = (*updates)[i];
+        switch (update.type) {
+            case ADD_EDGE:
+            case REMOVE_EDGE:
+                if (!exists(update.u) || !exists(update.v))
+                    throw std::logic_error("Update " + std::to_string(i) + " of the batch is on the edge {"
+                        + std::to_string(update.u) + ", " + std::to_string(update.v)
+                        + "} with a removed or unknown endpoint.");
+                if (update.u != update.v)
+                    edge_ops.push_back(std::make_tuple(std::min(update.u, update.v),
+                        std::max(update.u, update.v), i, update.type == ADD_EDGE));
+                break;
+            case ADD_VERTEX:
+                next_id++;
+                break;
+            case REMOVE_VERTEX:
+                if (update.u >= next_id)
+                    throw std::out_of_range("Update " + std::to_string(i) + " of the batch removes the unknown vertex "
+                        + std::to_string(update.u) + ".");
+                if (exists(update.u))
+                    removed_in_batch.insert(update.u);
+                break;
+            default:
+                break; // queries are ignored
+        }
+    }
+    std::vector<unsigned long> removed_vertices(removed_in_batch.begin(), removed_in_batch.end());
+    std::sort(removed_vertices.begin(), removed_vertices.end());
+    // the last operation on each edge decides its final state, and the
+    // edges of the vertices removed in the batch are dropped with them
+    std::sort(edge_ops.begin(), edge_ops.end());
+    auto added = new std::vector<std::pair<unsigned long, unsigned long>>();
+    auto removed = new std::vector<std::pair<unsigned long, unsigned long>>();
+    for(unsigned long i = 0ul; i < edge_ops.size(); ++i) {
+        auto u = std::get<0>(edge_ops[i]), v = std::get<1>(edge_ops[i]);
+        if (i + 1 < edge_ops.size() && std::get<0>(edge_ops[i + 1]) == u && std::get<1>(edge_ops[i + 1]) == v)
+            continue; // not the last operation on {u,v}
+        if (std::binary_search(removed_vertices.begin(), removed_vertices.end(), u)
+            || std::binary_search(removed_vertices.begin(), removed_vertices.end(), v))
+            continue;
+        bool present = v < id_bound && this->g->is_in_neigh_plus(u, v);
+        if (std::get<3>(edge_ops[i]) && !present)
+            added->push_back(std::make_pair(u, v));
+        else if (!std::get<3>(edge_ops[i]) && present)
+            removed->push_back(std::make_pair(u, v));
+    }
+    // applying the changes to g
+    stat_add(STAT_UPDATES_APPLIED, added->size() + removed->size() + (next_id - this->g->get_id_bound())
+        + removed_vertices.size());
+    while (this->g->get_id_bound() < next_id) {
+        auto v = this->g->add_vertex();
+        while (this->naos->get_n() <= v)
+            this->naos->add_vertex();
+    }
+    this->g->apply_edge_changes(added, removed, this->num_threads);
+    for(auto e: *added) {
+        this->pending_dirty->push_back(e.first);
+        this->pending_dirty->push_back(e.second);
+    }
+    for(auto e: *removed) {
+        this->pending_dirty->push_back(e.first);
+        this->pending_dirty->push_back(e.second);
+    }
+    for(auto v: removed_vertices) {
+        auto neigh_v = this->g->get_neighborhood(v);
+        this->pending_dirty->insert(this->pending_dirty->end(), neigh_v->begin(), neigh_v->end());
+        this->g->remove_vertex(v);
+        this->naos->remove_vertex(v);
+    }
+    delete removed;
+    delete added;
+    if (!defer_repair)
+        this->repair_pending_naos();
+}
+
+void IndexBasedCorrelationClustering::repair_pending_naos() {
+    if (this->pending_dirty->empty())
+        return;
+    PhaseTimer timer(PHASE_NAO_REPAIR);
+    auto dirty = this->pending_dirty;
+    this->pending_dirty = new std::vector<unsigned long>();
+    this->repair_dirty_naos(dirty);
+    delete dirty;
+}
+
+void IndexBasedCorrelationClustering::repair_dirty_naos(std::vector<unsigned long> *dirty) {
+    std::sort(dirty->begin(), dirty->end());
+    dirty->erase(std::unique(dirty->begin(), dirty->end()), dirty->end());
+    dirty->erase(std::remove_if(dirty->begin(), dirty->end(), [this](unsigned long x) {
+        return this->g->get_neighborhood(x) == nullptr; // x is removed
+    }), dirty->end());
+    // the NAO of a dirty vertex is rebuilt, as all its entries may have changed
+    auto rebuilt = new std::vector<std::vector<std::pair<unsigned long, na_key_t>>>(dirty->size());
+    parallel_for_weighted(dirty->size(),
+        [this, dirty](unsigned long i) {
+            double deg = this->g->get_neighborhood((*dirty)[i])->size();
+            return deg * std::log2(deg + 2.0) + 1.0;
+        },
+        [this, dirty, rebuilt](unsigned long i) {
+            auto x = (*dirty)[i];
+            auto neigh_x = this->g->get_neighborhood(x);
+            auto entries = &(*rebuilt)[i];
+            entries->reserve(neigh_x->size());
+            for(auto w: *neigh_x)
+                entries->push_back(std::make_pair(w, this->g->non_agreement_key(w, x)));
+        }, this->num_threads
+    );
+    // a clean neighbor w only needs the entries of its dirty neighbors, all
+    // of which are already present in NAO(w) since N^+(w) has not changed
+    std::unordered_map<unsigned long, std::vector<std::pair<unsigned long, na_key_t>>> patches;
+    for(unsigned long i = 0ul; i < dirty->size(); ++i) {
+        auto x = (*dirty)[i];
+        for(auto entry: (*rebuilt)[i]) {
+            if (!std::binary_search(dirty->begin(), dirty->end(), entry.first))
+                patches[entry.first].push_back(std::make_pair(x, entry.second));
+        }
+        this->naos->assign(x, (*rebuilt)[i]);
+        //< assign may move ranges, so it runs sequentially
+    }
+    delete rebuilt;
+    std::vector<std::pair<unsigned long, const std::vector<std::pair<unsigned long, na_key_t>>*>> patch_list;
+    patch_list.reserve(patches.size());
+    for(auto &patch: patches)
+        patch_list.push_back(std::make_pair(patch.first, &patch.second));
+    parallel_for_weighted(patch_list.size(),
+        [this, &patch_list](unsigned long i) {
+            return static_cast<double>(this->naos->size(patch_list[i].first) + patch_list[i].second->size());
+        },
+        [this, &patch_list](unsigned long i) {
+            this->naos->update_existing(patch_list[i].first, *patch_list[i].second);
+        }, this->num_threads
+    );
+}
+
+unsigned long IndexBasedCorrelationClustering::get_id_bound() {
+    return (this->g) ? this->g->get_id_bound() : this->csr->get_n();
+}
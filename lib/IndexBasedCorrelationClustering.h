@@ -9,32 +9,99 @@
 
 #ifndef INDEX_BASED_CORRELATION_CLUSTERING_H_
 #define INDEX_BASED_CORRELATION_CLUSTERING_H_
-#include <stack>
 #include <set>
 #include <cassert>
 #include "NaiveCorrelationClustering.h"
+#include <memory>
 #include "NAO.h"
+#include "NAOArena.h"
+#include "EdgeOrder.h"
+#include "UpdateLog.h"
 
 class IndexBasedCorrelationClustering : protected NaiveCorrelationClustering {
     protected:
         /**
-         * @brief storing NAOs for all vertices in the graph 
+         * @brief storing NAOs for all vertices in the graph, in one arena
          * 
          */
-        std::unordered_map<unsigned long, NAO*> *naos;
+        NAOArena *naos;
         /**
-         * @brief removes all non-agreement edges from g using NAOs
+         * @brief the positive edges sorted by non-agreement, over naos
+         * 
+         */
+        EdgeOrder *edge_order;
+        /**
+         * @brief number of threads used to (re)build the NAOs, 0 means all hardware threads
+         * 
+         */
+        unsigned int num_threads;
+        /**
+         * @brief the vertices whose positive neighborhood has changed by a
+         * deferred batch, whose NAOs (and the entries of their neighbors)
+         * are not repaired yet
+         * 
+         */
+        std::vector<unsigned long> *pending_dirty;
+        /**
+         * @brief the number of vertex ids, which may grow by add_vertex
+         * 
+         * @return unsigned long 
+         */
+        unsigned long get_id_bound();
+        /**
+         * @brief throws std::logic_error if this object runs on a snapshot
+         * only, hence it has no dynamic graph to update
+         * 
+         */
+        void ensure_dynamic();
+        /**
+         * @brief recomputes the non-agreement of every positive edge incident
+         * to a vertex in touched and patches the NAOs of both its endpoints
+         * @details these are exactly the edges whose non-agreement may change
+         * after adding/removing edges between the vertices in touched, since
+         * NonAgreement(x,y) only depends on N^+(x) and N^+(y)
+         * 
+         * @param touched the vertices whose positive neighborhood has changed
+         */
+        void repair_naos_around(const std::vector<unsigned long> &touched);
+        /**
+         * @brief rebuilds the NAO of every dirty vertex in parallel, and then
+         * patches the entries of the dirty vertices in the NAOs of their
+         * clean neighbors, each NAO at most once and in parallel
+         * 
+         * @param dirty the vertices whose positive neighborhood has changed
+         */
+        void repair_dirty_naos(std::vector<unsigned long> *dirty);
+        /**
+         * @brief constructs the NAOs of all the vertices from the snapshot
+         * 
+         */
+        void build_naos();
+        /**
+         * @brief unites the endpoints of every positive edge which survives
+         * the pruning for eps, only the eps-agreement prefix of the edge
+         * order and of the NAOs changed since its last rebuild are read
          * 
          * @param eps 
+         * @param uf the union-find over the vertices of g
          */
-        void remove_non_agree_edges_and_light_with_index(double eps);
+        void unite_surviving_edges_with_index(double eps, UnionFind *uf);
     public:
         /**
          * @brief Construct a new Index-based Correlation Clustering object
          * 
          * @param g input graph
+         * @param num_threads number of threads to build the NAOs, 0 means all hardware threads
          */
-        IndexBasedCorrelationClustering(Graph *g);
+        IndexBasedCorrelationClustering(Graph *g, unsigned int num_threads = 0u);
+        /**
+         * @brief Construct a new Index-based Correlation Clustering object 
+         * directly on a CSR snapshot, without keeping a dynamic Graph
+         * 
+         * @param g input graph snapshot, which should outlive this object
+         * @param num_threads number of threads to build the NAOs, 0 means all hardware threads
+         */
+        IndexBasedCorrelationClustering(GraphCSR *g, unsigned int num_threads = 0u);
         /**
          * @brief Destroy the Index-based Correlation Clustering object
          * 
@@ -55,6 +122,94 @@ class IndexBasedCorrelationClustering : protected NaiveCorrelationClustering {
          * 
          */
         void reset_naos();
+        /**
+         * @brief Set the number of threads used by reset_naos and the updates
+         * 
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void set_num_threads(unsigned int num_threads) {
+            this->num_threads = num_threads;
+            this->naos->set_num_threads(num_threads);
+        };
+        /**
+         * @brief adds the positive edge {u,v} to g and repairs the affected NAOs
+         * 
+         * @param u vertex u
+         * @param v vertex v
+         */
+        void add_edge(unsigned long u, unsigned long v);
+        /**
+         * @brief removes the positive edge {u,v} from g and repairs the affected NAOs
+         * 
+         * @param u vertex u
+         * @param v vertex v
+         */
+        void remove_edge(unsigned long u, unsigned long v);
+        /**
+         * @brief adds a new isolated vertex to g, together with its (empty) NAO
+         * 
+         * @return unsigned long the id of the new vertex
+         */
+        unsigned long add_vertex();
+        /**
+         * @brief removes the vertex v and all its positive edges from g and
+         * repairs the NAOs of its former neighbors
+         * 
+         * @param v vertex id to be removed
+         */
+        void remove_vertex(unsigned long v);
+        /**
+         * @brief renumbers the live vertices densely, keeping their order,
+         * in g, the NAOs and the edge order, so the memory of g, the NAOs
+         * and the per-query arrays follows the live graph instead of all
+         * the ids ever assigned; it costs O(n + m) and is worth calling
+         * once a large part of the ids are removed
+         * @note the ids given to and returned by the other methods are the
+         * new ones afterwards, the caller translates the ids it keeps
+         * @throws std::logic_error if this object runs on a snapshot only
+         * 
+         * @return std::vector<unsigned long>* the new id of every former id,
+         * REMOVED_VERTEX_ID for the removed ones, owned by the caller
+         */
+        std::vector<unsigned long>* compact_ids();
+        /**
+         * @brief applies a batch of updates with the same result as applying
+         * them one by one, but touching every neighborhood and every NAO once
+         * @details The updates are validated first, so an invalid batch
+         * changes nothing. Opposing insert/delete operations on an edge
+         * cancel out (only the last operation on each edge matters, and only
+         * if it changes the graph), the surviving edge changes are merged
+         * into g one neighborhood at a time, vertices are added before and
+         * removed after them, and the NAOs of the vertices whose
+         * neighborhood has changed are rebuilt in parallel.
+         * @throws std::logic_error if an edge update has a removed or unknown endpoint
+         * @throws std::out_of_range if a vertex removal has an unknown id
+         * 
+         * @param updates the operations, QUERY operations are ignored
+         * @param defer_repair if true, the NAOs are repaired at the next query
+         * (or the next call needing them) instead of now, so several batches
+         * may be repaired together
+         */
+        void apply_batch(const std::vector<Update> *updates, bool defer_repair = false);
+        /**
+         * @brief repairs the NAOs left dirty by deferred batches, if any
+         * 
+         */
+        void repair_pending_naos();
+        /**
+         * @brief Get a copy of the NAO of vertex v
+         * @throws std::out_of_range if v is removed or unknown
+         * 
+         * @param v vertex id
+         * @return std::unique_ptr<NAO> 
+         */
+        std::unique_ptr<NAO> get_nao(unsigned long v); // just for testing
+        /**
+         * @brief Get the arena of the NAOs
+         * 
+         * @return const NAOArena* 
+         */
+        const NAOArena *get_naos() { this->repair_pending_naos(); return this->naos; };
         /**
          * @brief Get the graph g as a pointer 
          * 
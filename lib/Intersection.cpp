@@ -0,0 +1,217 @@
+#include "Intersection.h"
+#include "Stats.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define INTERSECTION_X86 1
+#include <immintrin.h>
+#endif
+
+unsigned long intersection_count_scalar(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    unsigned long i = 0ul, j = 0ul, common = 0ul;
+    while (i < size_a && j < size_b) {
+        if (a[i] < b[j])
+            ++i;
+        else if (b[j] < a[i])
+            ++j;
+        else {
+            ++common;
+            ++i;
+            ++j;
+        }
+    }
+    return common;
+}
+
+unsigned long intersection_count_galloping(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    if (size_a > size_b) {
+        std::swap(a, b);
+        std::swap(size_a, size_b);
+    }
+    unsigned long common = 0ul, lo = 0ul;
+    for(unsigned long i = 0ul; i < size_a && lo < size_b; ++i) {
+        auto x = a[i];
+        // exponential search for the first b[k] >= x
+        unsigned long step = 1ul, hi = lo;
+        while (hi < size_b && b[hi] < x) {
+            lo = hi + 1;
+            hi += step;
+            step <<= 1;
+        }
+        hi = std::min(hi + 1, size_b);
+        lo = std::lower_bound(b + lo, b + hi, x) - b;
+        if (lo < size_b && b[lo] == x) {
+            ++common;
+            ++lo;
+        }
+    }
+    return common;
+}
+
+#ifdef INTERSECTION_X86
+
+#ifdef VERTEX_32BIT_IDS
+
+__attribute__((target("sse4.1,popcnt")))
+static unsigned long intersection_count_sse_impl(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    unsigned long i = 0ul, j = 0ul, common = 0ul;
+    while (i + 4 <= size_a && j + 4 <= size_b) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        // comparing va against all four rotations of vb
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        vb = _mm_shuffle_epi32(vb, 0x39);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+        vb = _mm_shuffle_epi32(vb, 0x39);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+        vb = _mm_shuffle_epi32(vb, 0x39);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+        common += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        auto max_a = a[i + 3], max_b = b[j + 3];
+        i += (max_a <= max_b) ? 4 : 0;
+        j += (max_b <= max_a) ? 4 : 0;
+    }
+    return common + intersection_count_scalar(a + i, size_a - i, b + j, size_b - j);
+}
+
+__attribute__((target("avx2,popcnt")))
+static unsigned long intersection_count_avx2_impl(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    unsigned long i = 0ul, j = 0ul, common = 0ul;
+    while (i + 8 <= size_a && j + 8 <= size_b) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        // comparing va against all eight rotations of vb
+        __m256i eq = _mm256_cmpeq_epi32(va, vb);
+        for(int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+        }
+        common += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        auto max_a = a[i + 7], max_b = b[j + 7];
+        i += (max_a <= max_b) ? 8 : 0;
+        j += (max_b <= max_a) ? 8 : 0;
+    }
+    return common + intersection_count_scalar(a + i, size_a - i, b + j, size_b - j);
+}
+
+#else
+
+__attribute__((target("sse4.1,popcnt")))
+static unsigned long intersection_count_sse_impl(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    unsigned long i = 0ul, j = 0ul, common = 0ul;
+    while (i + 2 <= size_a && j + 2 <= size_b) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i eq = _mm_or_si128(
+            _mm_cmpeq_epi64(va, vb),
+            _mm_cmpeq_epi64(va, _mm_shuffle_epi32(vb, 0x4E))
+        );
+        common += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(eq)));
+        auto max_a = a[i + 1], max_b = b[j + 1];
+        i += (max_a <= max_b) ? 2 : 0;
+        j += (max_b <= max_a) ? 2 : 0;
+    }
+    return common + intersection_count_scalar(a + i, size_a - i, b + j, size_b - j);
+}
+
+__attribute__((target("avx2,popcnt")))
+static unsigned long intersection_count_avx2_impl(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    unsigned long i = 0ul, j = 0ul, common = 0ul;
+    while (i + 4 <= size_a && j + 4 <= size_b) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        // comparing va against all four rotations of vb
+        __m256i eq = _mm256_cmpeq_epi64(va, vb);
+        vb = _mm256_permute4x64_epi64(vb, 0x39);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+        vb = _mm256_permute4x64_epi64(vb, 0x39);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+        vb = _mm256_permute4x64_epi64(vb, 0x39);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+        common += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+        auto max_a = a[i + 3], max_b = b[j + 3];
+        i += (max_a <= max_b) ? 4 : 0;
+        j += (max_b <= max_a) ? 4 : 0;
+    }
+    return common + intersection_count_scalar(a + i, size_a - i, b + j, size_b - j);
+}
+
+#endif // VERTEX_32BIT_IDS
+
+#endif // INTERSECTION_X86
+
+unsigned long intersection_count_sse(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+#ifdef INTERSECTION_X86
+    if (__builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt"))
+        return intersection_count_sse_impl(a, size_a, b, size_b);
+#endif
+    return intersection_count_scalar(a, size_a, b, size_b);
+}
+
+unsigned long intersection_count_avx2(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+#ifdef INTERSECTION_X86
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        return intersection_count_avx2_impl(a, size_a, b, size_b);
+#endif
+    return intersection_count_scalar(a, size_a, b, size_b);
+}
+
+typedef unsigned long (*intersection_kernel)(const vertex_id_t *, unsigned long,
+    const vertex_id_t *, unsigned long);
+
+/**
+ * @brief picks the widest merge kernel supported by the running CPU
+ *
+ * @param name the name of the selected kernel
+ * @return intersection_kernel
+ */
+static intersection_kernel select_merge_kernel(const char **name) {
+#ifdef INTERSECTION_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        *name = "avx2";
+        return intersection_count_avx2_impl;
+    }
+    if (__builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt")) {
+        *name = "sse4.1";
+        return intersection_count_sse_impl;
+    }
+#endif
+    *name = "scalar";
+    return intersection_count_scalar;
+}
+
+static const char *merge_kernel_name = "scalar";
+static const intersection_kernel merge_kernel = select_merge_kernel(&merge_kernel_name);
+
+const char * intersection_kernel_name() {
+    return merge_kernel_name;
+}
+
+unsigned long intersection_count(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b)
+{
+    stat_add(STAT_INTERSECTIONS);
+    if (size_a == 0ul || size_b == 0ul)
+        return 0ul;
+    if (size_a * GALLOPING_RATIO <= size_b || size_b * GALLOPING_RATIO <= size_a)
+        return intersection_count_galloping(a, size_a, b, size_b);
+    return merge_kernel(a, size_a, b, size_b);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file Intersection.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Allocation-free kernels counting the common elements of two sorted id lists
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef INTERSECTION_H_
+#define INTERSECTION_H_
+
+#include "VertexId.h"
+
+const unsigned long GALLOPING_RATIO = 32ul;
+///< @note Galloping search is used when one list is at least this many times longer than the other
+
+/**
+ * @brief returns |a \cap b| for two strictly increasing lists, choosing the
+ * kernel by the two lengths: galloping search when they are very unbalanced,
+ * otherwise the widest SIMD merge the CPU supports (AVX2, SSE4.1, or scalar)
+ * which is detected once at runtime
+ *
+ * @param a first sorted list
+ * @param size_a length of a
+ * @param b second sorted list
+ * @param size_b length of b
+ * @return unsigned long the number of common elements
+ */
+unsigned long intersection_count(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b);
+
+/**
+ * @brief plain scalar merge
+ *
+ * @see intersection_count
+ */
+unsigned long intersection_count_scalar(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b);
+
+/**
+ * @brief for each element of the shorter list, an exponential search
+ * followed by a binary search in the rest of the longer one
+ *
+ * @see intersection_count
+ */
+unsigned long intersection_count_galloping(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b);
+
+/**
+ * @brief block merge comparing 2x2 elements per step (SSE4.1), or 4x4 with
+ * -DVERTEX_32BIT_IDS, falls back to the scalar merge if it is not supported
+ *
+ * @see intersection_count
+ */
+unsigned long intersection_count_sse(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b);
+
+/**
+ * @brief block merge comparing 4x4 elements per step (AVX2), or 8x8 with
+ * -DVERTEX_32BIT_IDS, falls back to the scalar merge if it is not supported
+ *
+ * @see intersection_count
+ */
+unsigned long intersection_count_avx2(const vertex_id_t *a, unsigned long size_a,
+    const vertex_id_t *b, unsigned long size_b);
+
+/**
+ * @brief the name of the merge kernel selected for this CPU
+ *
+ * @return const char* one of "avx2", "sse4.1" or "scalar"
+ */
+const char * intersection_kernel_name();
+
+#endif // INTERSECTION_H_
@@ -0,0 +1,45 @@
+#include "LiveVertexSet.h"
+
+LiveVertexSet::LiveVertexSet(unsigned long id_bound) {
+    this->id_bound = id_bound;
+    this->num_live = id_bound;
+    this->words = new std::vector<std::uint64_t>((id_bound + 63ul) / 64ul, ~std::uint64_t(0));
+    if (id_bound % 64ul != 0ul)
+        this->words->back() = (std::uint64_t(1) << (id_bound % 64ul)) - 1ul;
+}
+
+LiveVertexSet::LiveVertexSet(const LiveVertexSet *other) {
+    this->id_bound = other->id_bound;
+    this->num_live = other->num_live;
+    this->words = new std::vector<std::uint64_t>(*other->words);
+}
+
+LiveVertexSet::~LiveVertexSet() {
+    delete this->words;
+}
+
+unsigned long LiveVertexSet::add() {
+    auto v = this->id_bound;
+    if (v % 64ul == 0ul)
+        this->words->push_back(0ul);
+    (*this->words)[v >> 6] |= std::uint64_t(1) << (v & 63ul);
+    this->id_bound++;
+    this->num_live++;
+    return v;
+}
+
+void LiveVertexSet::remove(unsigned long v) {
+    if (!this->contains(v))
+        return;
+    (*this->words)[v >> 6] &= ~(std::uint64_t(1) << (v & 63ul));
+    this->num_live--;
+}
+
+std::vector<unsigned long>* LiveVertexSet::compaction_map() const {
+    auto old_to_new = new std::vector<unsigned long>(this->id_bound, REMOVED_VERTEX_ID);
+    unsigned long next = 0ul;
+    this->for_each([&](unsigned long v) {
+        (*old_to_new)[v] = next++;
+    });
+    return old_to_new;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file LiveVertexSet.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief The set of the vertex ids which are not removed, as a bitmap
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef LIVE_VERTEX_SET_H_
+#define LIVE_VERTEX_SET_H_
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+const unsigned long REMOVED_VERTEX_ID = std::numeric_limits<unsigned long>::max();
+///< @note the new id of a removed vertex in the mapping of a compaction
+
+/**
+ * @brief The live, i.e., not removed, vertices among the ids [0, id_bound),
+ * one bit per id.
+ * @details A removed id is never reused, so after many deletions most of the
+ * id space may be dead. Iterating the set skips a word of 64 removed ids at
+ * a time, so a loop over the live vertices costs O(id_bound / 64 + live)
+ * instead of a test per id, and compaction_map renumbers the live ids
+ * densely once the dead ones are worth dropping.
+ */
+class LiveVertexSet {
+    protected:
+        std::vector<std::uint64_t> *words;
+        ///< bit v % 64 of words[v / 64] is set iff v is live, the bits from id_bound on are 0
+        unsigned long id_bound;
+        ///< one past the largest id ever added
+        unsigned long num_live;
+        ///< the number of set bits
+    public:
+        /**
+         * @brief Construct a new Live Vertex Set object of the live ids [0, id_bound)
+         *
+         * @param id_bound the number of ids, all live
+         */
+        LiveVertexSet(unsigned long id_bound = 0ul);
+        /**
+         * @brief Construct a new Live Vertex Set object identical to other
+         *
+         * @param other
+         */
+        LiveVertexSet(const LiveVertexSet *other);
+        /**
+         * @brief Destroy the Live Vertex Set object
+         *
+         */
+        ~LiveVertexSet();
+        /**
+         * @brief one past the largest id ever added, including the removed ones
+         *
+         * @return unsigned long
+         */
+        unsigned long get_id_bound() const { return this->id_bound; };
+        /**
+         * @brief the number of live ids
+         *
+         * @return unsigned long
+         */
+        unsigned long size() const { return this->num_live; };
+        /**
+         * @brief true iff v is a live id
+         *
+         * @param v vertex id, any value
+         * @return bool
+         */
+        bool contains(unsigned long v) const {
+            return v < this->id_bound && (((*this->words)[v >> 6] >> (v & 63ul)) & 1ul);
+        };
+        /**
+         * @brief adds the id id_bound as a live id
+         *
+         * @return unsigned long the new id
+         */
+        unsigned long add();
+        /**
+         * @brief marks v as removed, if it is live
+         *
+         * @param v vertex id
+         */
+        void remove(unsigned long v);
+        /**
+         * @brief calls fn(v) for every live id v, in increasing order
+         *
+         * @param fn called as fn(v)
+         */
+        template<typename F>
+        void for_each(F fn) const {
+            auto words = this->words->data();
+            for(unsigned long w = 0ul; w < this->words->size(); ++w) {
+                for(auto bits = words[w]; bits != 0ul; bits &= bits - 1ul)
+                    fn((w << 6) + static_cast<unsigned long>(__builtin_ctzll(bits)));
+            }
+        };
+        /**
+         * @brief the renumbering of a compaction: the i-th smallest live id
+         * becomes i, so the order of the live ids is kept
+         *
+         * @return std::vector<unsigned long>* the new id of every id below
+         * id_bound, REMOVED_VERTEX_ID for the removed ones
+         */
+        std::vector<unsigned long>* compaction_map() const;
+        /**
+         * @brief the number of bytes allocated by the set
+         *
+         * @return unsigned long
+         */
+        unsigned long memory_bytes() const {
+            return sizeof(LiveVertexSet) + this->words->capacity() * sizeof(std::uint64_t);
+        };
+};
+
+#endif // LIVE_VERTEX_SET_H_
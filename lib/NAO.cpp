@@ -1,4 +1,5 @@
 #include "NAO.h"
+#include "Parallel.h"
 
 NAO::NAO(unsigned long v, Graph *g) {
     this->v = v;
@@ -10,14 +11,60 @@ NAO::NAO(unsigned long v, Graph *g) {
             std::make_pair(u, g->non_agreement(u,v))
         );
     }
+    this->sort_nao();
+}
+
+NAO::NAO(unsigned long v, GraphCSR *g) {
+    this->v = v;
+    this->deg_v = g->deg_positive(v);
+    this->nao = new std::vector<std::pair<unsigned long, double>>();
+    this->nao->reserve(this->deg_v);
+    for(auto it = g->neighborhood_begin(v); it != g->neighborhood_end(v); ++it) {
+        this->nao->push_back(
+            std::make_pair(*it, g->non_agreement(*it, v))
+        );
+    }
+    this->sort_nao();
+}
+
+NAO::NAO(unsigned long v, GraphCSR *g, EdgeSupport *support) {
+    this->v = v;
+    this->deg_v = g->deg_positive(v);
+    this->nao = new std::vector<std::pair<unsigned long, double>>();
+    this->nao->reserve(this->deg_v);
+    for(auto slot = g->get_offset(v); slot < g->get_offset(v + 1); ++slot) {
+        this->nao->push_back(
+            std::make_pair(g->neighbor_at(slot), support->non_agreement_at(slot))
+        );
+    }
+    this->sort_nao();
+}
+
+NAO::NAO(unsigned long v, const std::vector<std::pair<unsigned long, double>> &entries) {
+    this->v = v;
+    this->deg_v = entries.size();
+    this->nao = new std::vector<std::pair<unsigned long, double>>(entries);
+    this->positions = new PositionIndex<vertex_id_t>(entries.size());
+    this->reindex(0ul);
+}
+
+void NAO::sort_nao() {
     std::sort(this->nao->begin(), this->nao->end(), 
         [](std::pair<unsigned long, double> a, std::pair<unsigned long, double> b) {
             return sort_order(a, b);
         }
     );
+    this->positions = new PositionIndex<vertex_id_t>(this->nao->size());
+    this->reindex(0ul);
+}
+
+void NAO::reindex(unsigned long from) {
+    for(auto i = from; i < this->nao->size(); ++i)
+        this->positions->set((*this->nao)[i].first, i);
 }
 
 NAO::~NAO() {
+    delete this->positions;
     delete this->nao;
 }
 
@@ -55,13 +102,11 @@ bool NAO::is_heavy(double eps) {
 }
 
 void NAO::add_update_positive_edge(unsigned long u, double nao) {
-    auto it = std::find_if(this->nao->begin(), this->nao->end(), 
-        [&u](std::pair<unsigned long, double> a) {
-            return a.first == u;
-        }
-    );
-    if (it != this->nao->end()) {
-        this->nao->erase(it);
+    auto pos = this->positions->find(u);
+    auto moved_from = this->nao->size();
+    if (pos != PositionIndex<vertex_id_t>::NOT_FOUND) {
+        this->nao->erase(this->nao->begin() + pos);
+        moved_from = pos;
     }
     else {
         this->deg_v++;
@@ -74,18 +119,46 @@ void NAO::add_update_positive_edge(unsigned long u, double nao) {
         }
     );
     //< note that here we compare the second element in the pair
+    moved_from = std::min<unsigned long>(moved_from, where - this->nao->begin());
     this->nao->insert(where, std::make_pair(u, nao));
     //< adding the element to its sorted place
+    this->reindex(moved_from);
+    //< only the entries after the first moved one have new positions
 }
 
-void NAO::remove_positive_edge(unsigned long u) {
-    auto it = std::find_if(this->nao->begin(), this->nao->end(), 
-        [&u](std::pair<unsigned long, double> a) {
-            return a.first == u;
+void NAO::add_update_positive_edges(const std::vector<std::pair<unsigned long, double>> &edges) {
+    if (edges.empty())
+        return;
+    std::vector<unsigned long> changed;
+    changed.reserve(edges.size());
+    for(auto &e: edges)
+        changed.push_back(e.first);
+    std::sort(changed.begin(), changed.end());
+    // dropping the entries which are going to be re-inserted
+    unsigned long found = 0ul;
+    auto last = std::remove_if(this->nao->begin(), this->nao->end(),
+        [&changed, &found](std::pair<unsigned long, double> a) {
+            bool is_changed = std::binary_search(changed.begin(), changed.end(), a.first);
+            found += is_changed;
+            return is_changed;
         }
     );
-    if (it != this->nao->end()) {
-        this->nao->erase(it);
+    auto kept = last - this->nao->begin();
+    this->nao->erase(last, this->nao->end());
+    this->deg_v += edges.size() - found;
+    //< the edges which were not found are new positive edges
+    this->nao->insert(this->nao->end(), edges.begin(), edges.end());
+    std::sort(this->nao->begin() + kept, this->nao->end(), sort_order);
+    std::inplace_merge(this->nao->begin(), this->nao->begin() + kept, this->nao->end(), sort_order);
+    this->reindex(0ul);
+}
+
+void NAO::remove_positive_edge(unsigned long u) {
+    auto pos = this->positions->find(u);
+    if (pos != PositionIndex<vertex_id_t>::NOT_FOUND) {
+        this->nao->erase(this->nao->begin() + pos);
+        this->positions->erase(u);
+        this->reindex(pos);
         this->deg_v--;
     }
     //< otherwise, this edge was not in the positive neighborhood
@@ -96,15 +169,32 @@ bool sort_order(std::pair<unsigned long, double> a, std::pair<unsigned long, dou
 }
 
 double NAO::query_na(unsigned long u) {
-    auto it = std::find_if(this->nao->begin(), this->nao->end(), 
-        [&u](std::pair<unsigned long, double> a) {
-            return a.first == u;
-        }
-    );
-    if (it != this->nao->end()) {
-        return (*it).second;
+    auto pos = this->positions->find(u);
+    if (pos != PositionIndex<vertex_id_t>::NOT_FOUND) {
+        return (*this->nao)[pos].second;
     }
     else {
         return INVALID_NON_AGREEMENT;
     }
-}
\ No newline at end of file
+}
+std::vector<NAO*>* construct_naos(GraphCSR *g, unsigned int num_threads) {
+    auto support = new EdgeSupport(g, num_threads);
+    auto naos = construct_naos(g, support, num_threads);
+    delete support;
+    return naos;
+}
+
+std::vector<NAO*>* construct_naos(GraphCSR *g, EdgeSupport *support, unsigned int num_threads) {
+    auto n = g->get_n();
+    auto naos = new std::vector<NAO*>(n, nullptr);
+    parallel_for_weighted(n, 
+        [g](unsigned long v) {
+            double deg = g->deg_positive(v);
+            return deg * std::log2(deg + 2.0) + 1.0;
+        },
+        [g, support, naos](unsigned long v) {
+            (*naos)[v] = new NAO(v, g, support);
+        }, num_threads
+    );
+    return naos;
+}
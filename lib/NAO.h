@@ -13,6 +13,9 @@
 #include<vector>
 #include<cmath>
 #include "Graph.h"
+#include "GraphCSR.h"
+#include "EdgeSupport.h"
+#include "PositionIndex.h"
 
 class NAO {
     protected:
@@ -23,6 +26,22 @@ class NAO {
         ///< this is NAO(v)
         unsigned long deg_v; 
         ///< deg_v in G^+
+        PositionIndex<vertex_id_t> *positions;
+        ///< the position of each neighbor in nao, so a neighbor is found
+        ///< without scanning
+        /**
+         * @brief sorts the entries of nao in increasing order of their non-agreement
+         * and indexes their positions
+         * 
+         */
+        void sort_nao();
+        /**
+         * @brief updates the positions of the entries of nao from the given one on,
+         * after they have moved
+         * 
+         * @param from the first position which may have changed
+         */
+        void reindex(unsigned long from);
     public:
         /**
          * @brief Construct a new NAO for vertex v using the graph g
@@ -31,6 +50,30 @@ class NAO {
          * @param g the graph G
          */
         NAO(unsigned long v, Graph *g);
+        /**
+         * @brief Construct a new NAO for vertex v using the CSR snapshot g
+         * 
+         * @param v vertex index in graph G
+         * @param g the CSR snapshot of graph G
+         */
+        NAO(unsigned long v, GraphCSR *g);
+        /**
+         * @brief Construct a new NAO for vertex v reading the non-agreements
+         * from a precomputed edge support table instead of intersecting
+         * 
+         * @param v vertex index in graph G
+         * @param g the CSR snapshot of graph G
+         * @param support the edge support table of g
+         */
+        NAO(unsigned long v, GraphCSR *g, EdgeSupport *support);
+        /**
+         * @brief Construct a new NAO for vertex v from its entries
+         * 
+         * @param v vertex index in graph G
+         * @param entries pairs of the neighbors of v and their non-agreement with v,
+         * in increasing order of the non-agreement
+         */
+        NAO(unsigned long v, const std::vector<std::pair<unsigned long, double>> &entries);
         /**
          * @brief Destroy the NAO object
          * 
@@ -67,6 +110,15 @@ class NAO {
          * @param noa the value of u and v non-agreement
          */
         void add_update_positive_edge(unsigned long u, double noa);
+        /**
+         * @brief adds or updates several positive edges {v,u} at once
+         * @details the changed entries are dropped in one pass, and the
+         * changes, sorted by their non-agreement, are merged back, so it
+         * costs O(deg(v) log k + k log k) for k changes instead of O(k deg(v))
+         * 
+         * @param edges pairs of the other endpoint u and the non-agreement of {u,v}, with distinct u
+         */
+        void add_update_positive_edges(const std::vector<std::pair<unsigned long, double>> &edges);
         /**
          * @brief removes an existing positive edge {v,u}
          * 
@@ -83,6 +135,30 @@ class NAO {
         }
 };
 
+/**
+ * @brief constructs the NAOs of all the vertices of g in parallel
+ * @details The non-agreements of all edges are computed once, by an
+ * EdgeSupport pass, and then each NAO(v) is a sort of deg(v) values read
+ * from that table. Building NAO(v) costs about deg(v) log deg(v), so the
+ * vertices are distributed among the threads by this weight rather than
+ * by count.
+ * 
+ * @param g the CSR snapshot of graph G
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return std::vector<NAO*>* the NAO of vertex v at index v
+ */
+std::vector<NAO*>* construct_naos(GraphCSR *g, unsigned int num_threads = 0u);
+/**
+ * @brief constructs the NAOs of all the vertices of g in parallel from an
+ * already computed edge support table
+ * 
+ * @param g the CSR snapshot of graph G
+ * @param support the edge support table of g
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return std::vector<NAO*>* the NAO of vertex v at index v
+ */
+std::vector<NAO*>* construct_naos(GraphCSR *g, EdgeSupport *support, unsigned int num_threads = 0u);
+
 /**
  * @brief internal function used for sorting the elements
  * 
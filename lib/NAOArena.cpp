@@ -0,0 +1,588 @@
+#include "NAOArena.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+/**
+ * @brief the double next to a non-negative x, as std::nextafter without the
+ * library call, since the bit patterns of non-negative doubles are ordered
+ *
+ * @param x a finite double, non-negative
+ * @param up towards larger doubles, otherwise towards 0
+ * @return double
+ */
+static inline double next_double(double x, bool up) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    if (up)
+        bits++;
+    else if (bits > 0u)
+        bits--;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+/**
+ * @brief the largest double e in [0, 4) for which pred(e) is false, for a
+ * predicate which is false at 0 and, once true, stays true for larger e
+ * @details It first walks a few doubles from a guess, which finds the answer
+ * in almost all the calls, and otherwise binary searches the bit
+ * patterns of the non-negative doubles, which are ordered as integers.
+ *
+ * @param guess a close estimate of the answer
+ * @param pred the monotone predicate
+ * @return double
+ */
+template<typename P>
+static double last_false(double guess, P pred) {
+    const int STEPS = 8;
+    if (guess >= 0.0 && guess < 4.0) {
+        // walking a few doubles from the guess towards the change of pred
+        bool at_guess = pred(guess);
+        auto e = guess;
+        for(int step = 0; step < STEPS; ++step) {
+            auto next = next_double(e, !at_guess);
+            if (pred(next) != at_guess)
+                return at_guess ? next : e;
+            e = next;
+        }
+    }
+    auto to_bits = [](double x) { std::uint64_t b; std::memcpy(&b, &x, sizeof(b)); return b; };
+    auto to_double = [](std::uint64_t b) { double x; std::memcpy(&x, &b, sizeof(x)); return x; };
+    std::uint64_t lo = to_bits(0.0), hi = to_bits(4.0);
+    while (hi - lo > 1u) {
+        auto mid = lo + (hi - lo) / 2u;
+        if (pred(to_double(mid)))
+            hi = mid;
+        else
+            lo = mid;
+    }
+    return to_double(lo);
+}
+
+NAOArena::NAOArena(GraphCSR *g, EdgeSupport *support, unsigned int num_threads) {
+    this->build(g, support, num_threads);
+}
+
+NAOArena::NAOArena(GraphCSR *g, unsigned int num_threads) {
+    auto support = new EdgeSupport(g, num_threads);
+    this->build(g, support, num_threads);
+    delete support;
+}
+
+NAOArena::~NAOArena() {
+    delete this->changed_epochs;
+    delete this->heavy_counts;
+    delete this->heavy_hi;
+    delete this->heavy_lo;
+    for(auto index: *this->indexes)
+        delete index;
+    delete this->indexes;
+    delete this->keys;
+    delete this->ids;
+    delete this->present;
+    delete this->capacities;
+    delete this->sizes;
+    delete this->begins;
+}
+
+void NAOArena::build(GraphCSR *g, EdgeSupport *support, unsigned int num_threads) {
+    PhaseTimer timer(PHASE_NAO_BUILD);
+    this->num_threads = num_threads;
+    auto n = g->get_n();
+    check_vertex_id_bound(n);
+    this->begins = new std::vector<unsigned long>(n);
+    this->sizes = new std::vector<nao_id_t>(n, 0);
+    this->capacities = new std::vector<nao_id_t>(n);
+    this->present = new LiveVertexSet(g->get_live_vertices());
+    this->indexes = new std::vector<PositionIndex<nao_id_t>*>(n, nullptr);
+    this->heavy_lo = new std::vector<double>(n * NAO_ARENA_HEAVY_INTERVALS, 0.0);
+    this->heavy_hi = new std::vector<double>(n * NAO_ARENA_HEAVY_INTERVALS, 0.0);
+    this->heavy_counts = new std::vector<unsigned char>(n, 0);
+    this->changed_epochs = new std::vector<unsigned long>(n, 0ul);
+    this->epoch = 0ul;
+    unsigned long total = 0ul;
+    for(unsigned long v = 0ul; v < n; ++v) {
+        (*this->begins)[v] = total;
+        (*this->capacities)[v] = this->has(v) ? capacity_for(g->deg_positive(v)) : 0ul;
+        total += (*this->capacities)[v];
+    }
+    this->ids = new std::vector<nao_id_t>(total);
+    this->keys = new std::vector<nao_key_t>(total);
+    this->garbage = 0ul;
+    auto threads = resolve_num_threads(num_threads);
+    auto buffers = new std::vector<std::vector<std::pair<nao_key_t, nao_id_t>>>(threads);
+    parallel_for_weighted_indexed(n,
+        [g](unsigned long v) {
+            double deg = g->deg_positive(v);
+            return deg * std::log2(deg + 2.0) + 1.0;
+        },
+        [&](unsigned long v, unsigned int t) {
+            auto buffer = &(*buffers)[t];
+            buffer->clear();
+            for(auto slot = g->get_offset(v); slot < g->get_offset(v + 1); ++slot) {
+                buffer->push_back(std::make_pair(to_nao_key(support->key_at(slot)),
+                    static_cast<nao_id_t>(g->neighbor_at(slot))));
+            }
+            this->write_sorted(v, *buffer);
+        }, threads
+    );
+    delete buffers;
+    this->refresh_heavy_intervals(threads);
+}
+
+void NAOArena::write_sorted(unsigned long v, std::vector<std::pair<nao_key_t, nao_id_t>> &entries) {
+    std::sort(entries.begin(), entries.end());
+    auto begin = (*this->begins)[v];
+    for(unsigned long i = 0ul; i < entries.size(); ++i) {
+        (*this->keys)[begin + i] = entries[i].first;
+        (*this->ids)[begin + i] = entries[i].second;
+    }
+    (*this->sizes)[v] = entries.size();
+    this->index_positions(v, 0ul);
+    this->mark_changed(v);
+}
+
+void NAOArena::index_positions(unsigned long v, unsigned long from) {
+    auto index = (*this->indexes)[v];
+    unsigned long deg = (*this->sizes)[v];
+    if (index == nullptr) {
+        if (deg < NAO_ARENA_INDEX_MIN_DEG)
+            return;
+        index = new PositionIndex<nao_id_t>(deg);
+        (*this->indexes)[v] = index;
+        from = 0ul;
+    }
+    else if (2 * deg < NAO_ARENA_INDEX_MIN_DEG) {
+        delete index;
+        (*this->indexes)[v] = nullptr;
+        return;
+    }
+    auto ids_v = this->ids_of(v);
+    for(auto i = from; i < deg; ++i)
+        index->set(ids_v[i], static_cast<nao_id_t>(i));
+}
+
+bool NAOArena::is_heavy(unsigned long v, double eps, na_key_t threshold) const {
+    if (!this->has(v))
+        return false;
+    unsigned long deg = (*this->sizes)[v];
+    unsigned long eps_th = static_cast<unsigned long>(std::ceil(eps * deg));
+    if (deg > 0)
+        eps_th--;
+    else
+        return false;
+    //< the same threshold as NAO::is_heavy
+    return (eps_th < deg && this->keys_of(v)[eps_th] < threshold);
+}
+
+std::vector<std::pair<double, double>> NAOArena::heavy_intervals(unsigned long v) const {
+    std::vector<std::pair<double, double>> intervals;
+    if (!this->has(v))
+        return intervals;
+    unsigned long deg = (*this->sizes)[v];
+    auto keys_v = this->keys_of(v);
+    // is_heavy reads the entry ceil(eps * deg) - 1, which is t for the eps in
+    // (bound(t), bound(t + 1)], where bound(k) is the last eps with eps * deg <= k
+    auto bound = [deg](unsigned long k) {
+        return last_false(static_cast<double>(k) / deg, [deg, k](double e) { return e * deg > k; });
+    };
+    const double LARGE_KEY_DOUBLE = std::ldexp(1.0, -8);
+    double lo_t = 0.0;
+    for(unsigned long t = 0ul; t < deg; ++t) {
+        auto hi_t = bound(t + 1);
+        auto key_t = keys_v[t];
+        auto x_t = na_key_to_double(static_cast<na_key_t>(key_t) << NAO_KEY_SHIFT);
+        // whether the t-th non-agreement is below eps, which is monotone in eps;
+        // for full keys above 2^-8 it is the comparison of the doubles (see eps_to_key)
+        bool as_double = (NAO_KEY_SHIFT == 0u && x_t > LARGE_KEY_DOUBLE);
+        auto below = [key_t, x_t, as_double](double e) {
+            return as_double ? (x_t < e) : (key_t < to_nao_threshold(eps_to_key(e)));
+        };
+        if (lo_t < hi_t && below(hi_t)) {
+            auto lo = lo_t;
+            if (!below(next_double(lo_t, true)))
+                lo = as_double ? x_t : last_false(x_t, below);
+            if (!intervals.empty() && intervals.back().second == lo)
+                intervals.back().second = hi_t;
+            else
+                intervals.push_back(std::make_pair(lo, hi_t));
+        }
+        lo_t = hi_t;
+    }
+    return intervals;
+}
+
+void NAOArena::update_heavy_intervals(unsigned long v) {
+    auto intervals = this->heavy_intervals(v);
+    auto first = v * NAO_ARENA_HEAVY_INTERVALS;
+    for(unsigned long j = 0ul; j < NAO_ARENA_HEAVY_INTERVALS; ++j) {
+        bool inline_interval = j < intervals.size() && intervals.size() <= NAO_ARENA_HEAVY_INTERVALS;
+        (*this->heavy_lo)[first + j] = inline_interval ? intervals[j].first : 0.0;
+        (*this->heavy_hi)[first + j] = inline_interval ? intervals[j].second : 0.0;
+    }
+    (*this->heavy_counts)[v] = (intervals.size() <= NAO_ARENA_HEAVY_INTERVALS)
+        ? static_cast<unsigned char>(intervals.size()) : NAO_ARENA_MANY_INTERVALS;
+}
+
+void NAOArena::mark_changed(unsigned long v) {
+    auto first = v * NAO_ARENA_HEAVY_INTERVALS;
+    std::fill(this->heavy_lo->begin() + first, this->heavy_lo->begin() + first + NAO_ARENA_HEAVY_INTERVALS, 0.0);
+    std::fill(this->heavy_hi->begin() + first, this->heavy_hi->begin() + first + NAO_ARENA_HEAVY_INTERVALS, 0.0);
+    (*this->heavy_counts)[v] = this->has(v) ? NAO_ARENA_STALE_INTERVALS : 0;
+    //< a removed vertex has no intervals, as it is never heavy
+    (*this->changed_epochs)[v] = this->epoch;
+}
+
+void NAOArena::refresh_heavy_intervals(unsigned int num_threads) {
+    std::vector<unsigned long> stale;
+    this->present->for_each([this, &stale](unsigned long v) {
+        if ((*this->heavy_counts)[v] == NAO_ARENA_STALE_INTERVALS)
+            stale.push_back(v);
+    });
+    parallel_for_weighted(stale.size(),
+        [this, &stale](unsigned long i) { return (*this->sizes)[stale[i]] + 1.0; },
+        [this, &stale](unsigned long i) { this->update_heavy_intervals(stale[i]); },
+        (stale.size() < 64ul) ? 1u : num_threads
+    );
+}
+
+void NAOArena::classify_heavy(double eps, std::vector<unsigned char> *heavy) const {
+    auto n = this->get_n();
+    heavy->assign(n, 0);
+    auto lo = this->heavy_lo->data();
+    auto hi = this->heavy_hi->data();
+    auto out = heavy->data();
+    // the unused intervals are empty, so there is no branch on the counts
+    for(unsigned long v = 0ul; v < n; ++v) {
+        unsigned char is_in = 0;
+        for(unsigned long j = 0ul; j < NAO_ARENA_HEAVY_INTERVALS; ++j) {
+            auto i = v * NAO_ARENA_HEAVY_INTERVALS + j;
+            is_in |= static_cast<unsigned char>((lo[i] < eps) & (eps <= hi[i]));
+        }
+        out[v] = is_in;
+    }
+    auto threshold = to_nao_threshold(eps_to_key(eps));
+    for(unsigned long v = 0ul; v < n; ++v) {
+        if ((*this->heavy_counts)[v] > NAO_ARENA_HEAVY_INTERVALS)
+            //< many or stale intervals
+            out[v] = this->is_heavy(v, eps, threshold);
+    }
+}
+
+unsigned long NAOArena::find(unsigned long v, unsigned long u) const {
+    unsigned long deg = (*this->sizes)[v];
+    auto index = (*this->indexes)[v];
+    if (index != nullptr) {
+        if (u >= VERTEX_ID_BOUND)
+            return deg;
+        auto pos = index->find(static_cast<nao_id_t>(u));
+        return (pos == PositionIndex<nao_id_t>::NOT_FOUND) ? deg : pos;
+    }
+    auto ids_v = this->ids_of(v);
+    for(unsigned long i = 0ul; i < deg; ++i) {
+        if (ids_v[i] == u)
+            return i;
+    }
+    return deg;
+}
+
+na_key_t NAOArena::query_key(unsigned long v, unsigned long u) const {
+    if (!this->has(v))
+        return NA_KEY_INVALID;
+    auto pos = this->find(v, u);
+    if (pos == (*this->sizes)[v])
+        return NA_KEY_INVALID;
+    return static_cast<na_key_t>(this->keys_of(v)[pos]) << NAO_KEY_SHIFT;
+}
+
+void NAOArena::relocate(unsigned long v, unsigned long capacity) {
+    auto old_begin = (*this->begins)[v];
+    auto new_begin = this->ids->size();
+    this->ids->resize(new_begin + capacity);
+    this->keys->resize(new_begin + capacity);
+    std::copy(this->ids->begin() + old_begin, this->ids->begin() + old_begin + (*this->sizes)[v],
+        this->ids->begin() + new_begin);
+    std::copy(this->keys->begin() + old_begin, this->keys->begin() + old_begin + (*this->sizes)[v],
+        this->keys->begin() + new_begin);
+    this->garbage += (*this->capacities)[v];
+    (*this->begins)[v] = new_begin;
+    (*this->capacities)[v] = capacity;
+}
+
+void NAOArena::insert(unsigned long v, unsigned long u, na_key_t na) {
+    check_vertex_id_bound(u + 1);
+    this->remove(v, u);
+    unsigned long deg = (*this->sizes)[v];
+    if (deg == (*this->capacities)[v])
+        this->relocate(v, std::max(2 * deg, capacity_for(deg + 1)));
+    auto key = to_nao_key(na);
+    auto id = static_cast<nao_id_t>(u);
+    auto begin = (*this->begins)[v];
+    // the first position whose (key, id) is greater than the new one
+    auto keys_v = this->keys->data() + begin;
+    auto ids_v = this->ids->data() + begin;
+    auto pos = std::lower_bound(keys_v, keys_v + deg, key) - keys_v;
+    while (pos < static_cast<long>(deg) && keys_v[pos] == key && ids_v[pos] < id)
+        ++pos;
+    std::copy_backward(keys_v + pos, keys_v + deg, keys_v + deg + 1);
+    std::copy_backward(ids_v + pos, ids_v + deg, ids_v + deg + 1);
+    keys_v[pos] = key;
+    ids_v[pos] = id;
+    (*this->sizes)[v] = deg + 1;
+    this->index_positions(v, pos);
+    this->mark_changed(v);
+    this->maybe_compact();
+}
+
+void NAOArena::remove(unsigned long v, unsigned long u) {
+    auto pos = this->find(v, u);
+    unsigned long deg = (*this->sizes)[v];
+    if (pos == deg)
+        return;
+    auto begin = (*this->begins)[v];
+    std::copy(this->keys->begin() + begin + pos + 1, this->keys->begin() + begin + deg,
+        this->keys->begin() + begin + pos);
+    std::copy(this->ids->begin() + begin + pos + 1, this->ids->begin() + begin + deg,
+        this->ids->begin() + begin + pos);
+    (*this->sizes)[v] = deg - 1;
+    if ((*this->indexes)[v] != nullptr)
+        (*this->indexes)[v]->erase(static_cast<nao_id_t>(u));
+    this->index_positions(v, pos);
+    this->mark_changed(v);
+}
+
+void NAOArena::update_existing(unsigned long v, const std::vector<std::pair<unsigned long, na_key_t>> &changes) {
+    if (changes.empty())
+        return;
+    std::vector<nao_id_t> changed;
+    changed.reserve(changes.size());
+    std::vector<std::pair<nao_key_t, nao_id_t>> changed_entries;
+    changed_entries.reserve(changes.size());
+    for(auto &c: changes) {
+        changed.push_back(static_cast<nao_id_t>(c.first));
+        changed_entries.push_back(std::make_pair(to_nao_key(c.second), static_cast<nao_id_t>(c.first)));
+    }
+    std::sort(changed.begin(), changed.end());
+    std::sort(changed_entries.begin(), changed_entries.end());
+    // dropping the changed entries in place, and merging them back in order
+    unsigned long deg = (*this->sizes)[v];
+    auto begin = (*this->begins)[v];
+    auto keys_v = this->keys->data() + begin;
+    auto ids_v = this->ids->data() + begin;
+    unsigned long kept = 0ul;
+    for(unsigned long i = 0ul; i < deg; ++i) {
+        if (!std::binary_search(changed.begin(), changed.end(), ids_v[i])) {
+            keys_v[kept] = keys_v[i];
+            ids_v[kept] = ids_v[i];
+            ++kept;
+        }
+    }
+    if (kept + changed_entries.size() != deg)
+        throw std::logic_error("NAOArena::update_existing got a neighbor which is not in NAO("
+            + std::to_string(v) + ")");
+    // merging from the back, so no extra buffer is needed for the kept entries
+    long i = static_cast<long>(kept) - 1, j = static_cast<long>(changed_entries.size()) - 1;
+    for(long out = static_cast<long>(deg) - 1; j >= 0; --out) {
+        if (i >= 0 && std::make_pair(keys_v[i], ids_v[i]) > changed_entries[j]) {
+            keys_v[out] = keys_v[i];
+            ids_v[out] = ids_v[i];
+            --i;
+        }
+        else {
+            keys_v[out] = changed_entries[j].first;
+            ids_v[out] = changed_entries[j].second;
+            --j;
+        }
+    }
+    this->index_positions(v, 0ul);
+    this->mark_changed(v);
+}
+
+void NAOArena::assign(unsigned long v, const std::vector<std::pair<unsigned long, na_key_t>> &entries) {
+    std::vector<std::pair<nao_key_t, nao_id_t>> sorted_entries;
+    sorted_entries.reserve(entries.size());
+    for(auto &e: entries) {
+        check_vertex_id_bound(e.first + 1);
+        sorted_entries.push_back(std::make_pair(to_nao_key(e.second), static_cast<nao_id_t>(e.first)));
+    }
+    if (entries.size() > (*this->capacities)[v]) {
+        // the old entries are not needed, so the range is abandoned rather than copied
+        (*this->sizes)[v] = 0;
+        this->relocate(v, capacity_for(entries.size()));
+    }
+    this->write_sorted(v, sorted_entries);
+    this->maybe_compact();
+}
+
+unsigned long NAOArena::add_vertex() {
+    auto v = this->begins->size();
+    check_vertex_id_bound(v + 1);
+    auto capacity = capacity_for(0ul);
+    this->begins->push_back(this->ids->size());
+    this->sizes->push_back(0);
+    this->capacities->push_back(capacity);
+    this->present->add();
+    this->indexes->push_back(nullptr);
+    this->heavy_lo->resize(this->heavy_lo->size() + NAO_ARENA_HEAVY_INTERVALS, 0.0);
+    this->heavy_hi->resize(this->heavy_hi->size() + NAO_ARENA_HEAVY_INTERVALS, 0.0);
+    this->heavy_counts->push_back(0);
+    this->changed_epochs->push_back(this->epoch);
+    this->ids->resize(this->ids->size() + capacity);
+    this->keys->resize(this->keys->size() + capacity);
+    return v;
+}
+
+void NAOArena::remove_vertex(unsigned long v) {
+    if (!this->has(v))
+        return;
+    this->present->remove(v);
+    this->mark_changed(v);
+    delete (*this->indexes)[v];
+    (*this->indexes)[v] = nullptr;
+    this->garbage += (*this->capacities)[v];
+    (*this->capacities)[v] = 0;
+    (*this->sizes)[v] = 0;
+    this->maybe_compact();
+}
+
+void NAOArena::maybe_compact() {
+    if (2 * this->garbage > this->ids->size())
+        this->compact();
+}
+
+void NAOArena::compact() {
+    auto n = this->get_n();
+    auto new_begins = new std::vector<unsigned long>(n);
+    unsigned long total = 0ul;
+    for(unsigned long v = 0ul; v < n; ++v) {
+        (*new_begins)[v] = total;
+        if (this->has(v)) {
+            (*this->capacities)[v] = capacity_for((*this->sizes)[v]);
+            total += (*this->capacities)[v];
+        }
+    }
+    auto new_ids = new std::vector<nao_id_t>(total);
+    auto new_keys = new std::vector<nao_key_t>(total);
+    parallel_for(0ul, n, [&](unsigned long v) {
+        auto begin = (*this->begins)[v];
+        auto deg = (*this->sizes)[v];
+        std::copy(this->ids->begin() + begin, this->ids->begin() + begin + deg, new_ids->begin() + (*new_begins)[v]);
+        std::copy(this->keys->begin() + begin, this->keys->begin() + begin + deg, new_keys->begin() + (*new_begins)[v]);
+    }, this->num_threads);
+    delete this->begins;
+    delete this->ids;
+    delete this->keys;
+    this->begins = new_begins;
+    this->ids = new_ids;
+    this->keys = new_keys;
+    this->garbage = 0ul;
+}
+
+void NAOArena::compact_ids(const std::vector<unsigned long> *old_to_new) {
+    auto n = this->present->size();
+    auto old_of = new std::vector<unsigned long>();
+    old_of->reserve(n);
+    this->present->for_each([old_of](unsigned long v) { old_of->push_back(v); });
+    //< the renumbering is increasing, so the v-th live vertex becomes v
+    auto new_begins = new std::vector<unsigned long>(n);
+    auto new_sizes = new std::vector<nao_id_t>(n);
+    auto new_capacities = new std::vector<nao_id_t>(n);
+    auto new_heavy_lo = new std::vector<double>(n * NAO_ARENA_HEAVY_INTERVALS);
+    auto new_heavy_hi = new std::vector<double>(n * NAO_ARENA_HEAVY_INTERVALS);
+    auto new_heavy_counts = new std::vector<unsigned char>(n);
+    auto new_changed_epochs = new std::vector<unsigned long>(n);
+    unsigned long total = 0ul;
+    for(unsigned long v = 0ul; v < n; ++v) {
+        auto old_v = (*old_of)[v];
+        (*new_begins)[v] = total;
+        (*new_sizes)[v] = (*this->sizes)[old_v];
+        (*new_capacities)[v] = capacity_for((*this->sizes)[old_v]);
+        total += (*new_capacities)[v];
+        // the heavy intervals only depend on the keys, which do not change
+        std::copy(this->heavy_lo->begin() + old_v * NAO_ARENA_HEAVY_INTERVALS,
+            this->heavy_lo->begin() + (old_v + 1) * NAO_ARENA_HEAVY_INTERVALS,
+            new_heavy_lo->begin() + v * NAO_ARENA_HEAVY_INTERVALS);
+        std::copy(this->heavy_hi->begin() + old_v * NAO_ARENA_HEAVY_INTERVALS,
+            this->heavy_hi->begin() + (old_v + 1) * NAO_ARENA_HEAVY_INTERVALS,
+            new_heavy_hi->begin() + v * NAO_ARENA_HEAVY_INTERVALS);
+        (*new_heavy_counts)[v] = (*this->heavy_counts)[old_v];
+        (*new_changed_epochs)[v] = (*this->changed_epochs)[old_v];
+    }
+    auto new_ids = new std::vector<nao_id_t>(total);
+    auto new_keys = new std::vector<nao_key_t>(total);
+    parallel_for(0ul, n, [&](unsigned long v) {
+        auto begin = (*this->begins)[(*old_of)[v]];
+        unsigned long deg = (*new_sizes)[v];
+        for(unsigned long i = 0ul; i < deg; ++i) {
+            assert((*old_to_new)[(*this->ids)[begin + i]] != REMOVED_VERTEX_ID);
+            (*new_ids)[(*new_begins)[v] + i] = static_cast<nao_id_t>((*old_to_new)[(*this->ids)[begin + i]]);
+        }
+        std::copy(this->keys->begin() + begin, this->keys->begin() + begin + deg, new_keys->begin() + (*new_begins)[v]);
+    }, this->num_threads);
+    for(auto index: *this->indexes)
+        delete index;
+    delete this->indexes;
+    delete this->changed_epochs;
+    delete this->heavy_counts;
+    delete this->heavy_hi;
+    delete this->heavy_lo;
+    delete this->keys;
+    delete this->ids;
+    delete this->present;
+    delete this->capacities;
+    delete this->sizes;
+    delete this->begins;
+    delete old_of;
+    this->begins = new_begins;
+    this->sizes = new_sizes;
+    this->capacities = new_capacities;
+    this->present = new LiveVertexSet(n);
+    this->ids = new_ids;
+    this->keys = new_keys;
+    this->heavy_lo = new_heavy_lo;
+    this->heavy_hi = new_heavy_hi;
+    this->heavy_counts = new_heavy_counts;
+    this->changed_epochs = new_changed_epochs;
+    this->garbage = 0ul;
+    // the position indexes map the ids, so they are built again for the new ones
+    this->indexes = new std::vector<PositionIndex<nao_id_t>*>(n, nullptr);
+    parallel_for(0ul, n, [this](unsigned long v) {
+        this->index_positions(v, 0ul);
+    }, this->num_threads);
+}
+
+std::vector<std::pair<unsigned long, double>> NAOArena::entries(unsigned long v) const {
+    std::vector<std::pair<unsigned long, double>> result;
+    if (!this->has(v))
+        return result;
+    unsigned long deg = (*this->sizes)[v];
+    result.reserve(deg);
+    for(unsigned long i = 0ul; i < deg; ++i)
+        result.push_back(std::make_pair(this->ids_of(v)[i],
+            na_key_to_double(static_cast<na_key_t>(this->keys_of(v)[i]) << NAO_KEY_SHIFT)));
+    return result;
+}
+
+unsigned long NAOArena::memory_bytes() const {
+    unsigned long index_bytes = this->indexes->capacity() * sizeof(PositionIndex<nao_id_t>*);
+    for(auto index: *this->indexes) {
+        if (index != nullptr)
+            index_bytes += index->memory_bytes();
+    }
+    return sizeof(NAOArena) + index_bytes
+        + (this->heavy_lo->capacity() + this->heavy_hi->capacity()) * sizeof(double)
+        + this->heavy_counts->capacity()
+        + this->changed_epochs->capacity() * sizeof(unsigned long)
+        + this->begins->capacity() * sizeof(unsigned long)
+        + this->sizes->capacity() * sizeof(nao_id_t)
+        + this->capacities->capacity() * sizeof(nao_id_t)
+        + this->present->memory_bytes()
+        + this->ids->capacity() * sizeof(nao_id_t)
+        + this->keys->capacity() * sizeof(nao_key_t);
+}
@@ -0,0 +1,376 @@
+/**
+ * @file NAOArena.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief The NAOs of all the vertices in one contiguous structure-of-arrays arena
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef NAO_ARENA_H_
+#define NAO_ARENA_H_
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include "GraphCSR.h"
+#include "LiveVertexSet.h"
+#include "EdgeSupport.h"
+#include "PositionIndex.h"
+#include "NonAgreement.h"
+#include "VertexId.h"
+
+typedef vertex_id_t nao_id_t;
+///< @note the type of the neighbor ids stored in the arena, see VertexId.h
+
+#ifdef NAO_COMPACT_KEYS
+typedef std::uint32_t nao_key_t;
+///< @note the type of the stored non-agreement keys, the top 32 bits of na_key_t with
+///< -DNAO_COMPACT_KEYS, which halves the key memory but merges non-agreements closer than
+///< 2^-31, so a non-agreement less than 2^-31 below eps may count as not below it
+const unsigned int NAO_KEY_SHIFT = NA_KEY_FRACTION_BITS + 1u - 32u;
+#else
+typedef na_key_t nao_key_t;
+///< @note the type of the stored non-agreement keys, the exact na_key_t unless -DNAO_COMPACT_KEYS
+const unsigned int NAO_KEY_SHIFT = 0u;
+#endif
+
+/**
+ * @brief the stored form of a non-agreement key
+ *
+ * @param key non-agreement key
+ * @return nao_key_t
+ */
+inline nao_key_t to_nao_key(na_key_t key) { return static_cast<nao_key_t>(key >> NAO_KEY_SHIFT); }
+
+/**
+ * @brief the threshold of eps in the scale of the stored keys: a stored key
+ * below it has a non-agreement below eps, and with -DNAO_COMPACT_KEYS the
+ * converse fails only for a non-agreement in the same 2^-31 bucket as eps
+ *
+ * @param eps_key the threshold key of eps, see eps_to_key
+ * @return na_key_t
+ */
+inline na_key_t to_nao_threshold(na_key_t eps_key) { return eps_key >> NAO_KEY_SHIFT; }
+
+const unsigned long NAO_ARENA_MIN_SLACK = 2ul;
+///< @note every NAO has room for at least this many inserts before it is moved
+const unsigned long NAO_ARENA_SLACK_DIVISOR = 8ul;
+///< @note and for deg/NAO_ARENA_SLACK_DIVISOR inserts for larger degrees
+const unsigned long NAO_ARENA_INDEX_MIN_DEG = 64ul;
+///< @note NAOs of at least this many entries get a PositionIndex, smaller ones are scanned,
+///< and an index is dropped once its NAO shrinks below half of this
+const unsigned long NAO_ARENA_HEAVY_INTERVALS = 2ul;
+///< @note the number of eps intervals in which a vertex is heavy that are kept inline per vertex
+const unsigned char NAO_ARENA_MANY_INTERVALS = 0xFF;
+///< @note the interval count of a vertex with more intervals than NAO_ARENA_HEAVY_INTERVALS
+const unsigned char NAO_ARENA_STALE_INTERVALS = 0xFE;
+///< @note the interval count of a vertex whose NAO changed since its intervals were computed
+
+/**
+ * @brief Stores NAO(v) for all vertex ids v in two shared arrays, the
+ * neighbor ids and the non-agreement keys (structure of arrays), where
+ * NAO(v) is the range [begin(v), begin(v) + size(v)) sorted by (key, id).
+ * @note Methods that may move ranges (insert, assign, add_vertex, compact)
+ * must not run concurrently with anything else; update_existing and all
+ * the const readers can run in parallel for distinct vertices.
+ */
+class NAOArena {
+    protected:
+        std::vector<unsigned long> *begins;
+        ///< the first slot of NAO(v)
+        std::vector<nao_id_t> *sizes;
+        ///< deg(v), the number of entries of NAO(v)
+        std::vector<nao_id_t> *capacities;
+        ///< the number of slots reserved for NAO(v), 0 for a removed vertex
+        LiveVertexSet *present;
+        ///< the vertices which are not removed, the only ones with a NAO
+        std::vector<nao_id_t> *ids;
+        ///< the neighbor ids of all NAOs
+        std::vector<nao_key_t> *keys;
+        ///< the non-agreement keys of all NAOs, aligned with ids
+        unsigned long garbage;
+        ///< the number of slots of abandoned ranges
+        std::vector<PositionIndex<nao_id_t>*> *indexes;
+        ///< the position index of NAO(v), nullptr if NAO(v) is small
+        std::vector<double> *heavy_lo;
+        ///< v is heavy for eps in (heavy_lo, heavy_hi] of its inline intervals, at
+        ///< [v * NAO_ARENA_HEAVY_INTERVALS, (v + 1) * NAO_ARENA_HEAVY_INTERVALS)
+        std::vector<double> *heavy_hi;
+        ///< the unused inline intervals are empty, i.e., (0, 0]
+        std::vector<unsigned char> *heavy_counts;
+        ///< the number of heavy intervals of v, or NAO_ARENA_MANY_INTERVALS, or NAO_ARENA_STALE_INTERVALS
+        std::vector<unsigned long> *changed_epochs;
+        ///< the epoch in which NAO(v) last changed
+        unsigned long epoch;
+        ///< the current epoch, advanced by the readers that cache what they derive from the NAOs
+        unsigned int num_threads;
+        ///< the threads of the compactions, 0 means all hardware threads
+        /**
+         * @brief the capacity reserved for a NAO of deg entries
+         *
+         * @param deg number of entries
+         * @return unsigned long
+         */
+        static unsigned long capacity_for(unsigned long deg) {
+            return deg + std::max(NAO_ARENA_MIN_SLACK, deg / NAO_ARENA_SLACK_DIVISOR);
+        };
+        /**
+         * @brief allocates the arena and fills the NAOs of all the vertices of g
+         *
+         * @param g the CSR snapshot of graph G
+         * @param support the edge support table of g
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void build(GraphCSR *g, EdgeSupport *support, unsigned int num_threads);
+        /**
+         * @brief compacts the arena if the abandoned ranges take more than half of it
+         *
+         */
+        void maybe_compact();
+        /**
+         * @brief moves NAO(v) to the end of the arena with at least the given capacity
+         *
+         * @param v vertex id
+         * @param capacity the new capacity
+         */
+        void relocate(unsigned long v, unsigned long capacity);
+        /**
+         * @brief returns the position of u in NAO(v), or size(v) if absent
+         *
+         * @param v vertex id
+         * @param u neighbor id
+         * @return unsigned long
+         */
+        unsigned long find(unsigned long v, unsigned long u) const;
+        /**
+         * @brief writes the given (id, key) pairs, sorted, into the range of v
+         *
+         * @param v vertex id
+         * @param entries at most capacity(v) entries
+         */
+        void write_sorted(unsigned long v, std::vector<std::pair<nao_key_t, nao_id_t>> &entries);
+        /**
+         * @brief updates the position index of v for the entries from the
+         * given position on, and creates or drops the index by the size of NAO(v)
+         *
+         * @param v vertex id
+         * @param from the first position which may have changed
+         */
+        void index_positions(unsigned long v, unsigned long from);
+        /**
+         * @brief recomputes the inline heavy intervals of v from NAO(v)
+         *
+         * @param v vertex id
+         */
+        void update_heavy_intervals(unsigned long v);
+        /**
+         * @brief records that NAO(v) changed: marks its heavy intervals stale
+         * and stamps it with the current epoch
+         *
+         * @param v vertex id
+         */
+        void mark_changed(unsigned long v);
+    public:
+        /**
+         * @brief builds the NAOs of all the vertices of g in parallel, reading
+         * the non-agreements from an edge support table
+         *
+         * @param g the CSR snapshot of graph G
+         * @param support the edge support table of g
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        NAOArena(GraphCSR *g, EdgeSupport *support, unsigned int num_threads = 0u);
+        /**
+         * @brief builds the NAOs of all the vertices of g in parallel
+         *
+         * @param g the CSR snapshot of graph G
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        NAOArena(GraphCSR *g, unsigned int num_threads = 0u);
+        /**
+         * @brief Destroy the NAOArena object
+         *
+         */
+        ~NAOArena();
+        /**
+         * @brief the number of vertex ids, including the removed ones
+         *
+         * @return unsigned long
+         */
+        unsigned long get_n() const { return this->begins->size(); };
+        /**
+         * @brief Set the number of threads of the compactions run by the updates
+         *
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void set_num_threads(unsigned int num_threads) { this->num_threads = num_threads; };
+        /**
+         * @brief true iff v has a NAO, i.e., it is a vertex id which is not removed
+         *
+         * @param v vertex id
+         * @return bool
+         */
+        bool has(unsigned long v) const { return this->present->contains(v); };
+        /**
+         * @brief the vertex ids which have a NAO, i.e., which are not removed
+         *
+         * @return const LiveVertexSet*
+         */
+        const LiveVertexSet * get_live_vertices() const { return this->present; };
+        /**
+         * @brief the epoch in which NAO(v) last changed, including being
+         * added or removed
+         *
+         * @param v vertex id
+         * @return unsigned long
+         */
+        unsigned long changed_at(unsigned long v) const { return (*this->changed_epochs)[v]; };
+        /**
+         * @brief starts a new epoch, so a reader which derived something from
+         * the NAOs can tell later which of them changed since
+         *
+         * @return unsigned long the ending epoch: NAO(v) changed after this
+         * call iff changed_at(v) is larger than it
+         */
+        unsigned long advance_epoch() { return this->epoch++; };
+        /**
+         * @brief deg(v), the number of entries of NAO(v)
+         *
+         * @param v vertex id
+         * @return unsigned long
+         */
+        unsigned long size(unsigned long v) const { return (*this->sizes)[v]; };
+        /**
+         * @brief the neighbor ids of NAO(v), in increasing order of their non-agreement
+         *
+         * @param v vertex id
+         * @return const nao_id_t*
+         */
+        const nao_id_t * ids_of(unsigned long v) const { return this->ids->data() + (*this->begins)[v]; };
+        /**
+         * @brief the non-agreement keys of NAO(v), in increasing order
+         *
+         * @param v vertex id
+         * @return const nao_key_t*
+         */
+        const nao_key_t * keys_of(unsigned long v) const { return this->keys->data() + (*this->begins)[v]; };
+        /**
+         * @brief returns true iff vertex v is eps-heavy, by the same rule as NAO::is_heavy
+         *
+         * @param v vertex id
+         * @param eps parameter eps
+         * @param threshold to_nao_threshold(eps_to_key(eps)), computed once per query
+         * @return bool
+         */
+        bool is_heavy(unsigned long v, double eps, na_key_t threshold) const;
+        /**
+         * @brief the eps intervals in which v is heavy, derived from NAO(v)
+         * @details With d = deg(v), for the eps with ceil(eps d) = t + 1 the
+         * vertex is heavy iff the t-th non-agreement of NAO(v) is below eps,
+         * so each t contributes at most one interval, and the touching ones
+         * are merged. The bounds are the exact doubles at which is_heavy
+         * changes, including the rounding of eps d and of the keys.
+         *
+         * @param v vertex id
+         * @return std::vector<std::pair<double, double>> disjoint intervals (lo, hi], increasing
+         */
+        std::vector<std::pair<double, double>> heavy_intervals(unsigned long v) const;
+        /**
+         * @brief classifies all the vertices for eps, the same as is_heavy for each
+         *
+         * @param eps parameter eps
+         * @param heavy set to 1 for the eps-heavy vertices and 0 otherwise, resized to get_n()
+         */
+        void classify_heavy(double eps, std::vector<unsigned char> *heavy) const;
+        /**
+         * @brief recomputes the heavy intervals of the vertices marked stale, in parallel
+         *
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        void refresh_heavy_intervals(unsigned int num_threads = 0u);
+        /**
+         * @brief gets the non-agreement key of u with v
+         *
+         * @param v vertex id
+         * @param u neighbor id
+         * @return na_key_t the key, or NA_KEY_INVALID if u is not in NAO(v)
+         */
+        na_key_t query_key(unsigned long v, unsigned long u) const;
+        /**
+         * @brief adds the entry of u to NAO(v), or updates its non-agreement
+         *
+         * @param v vertex id
+         * @param u neighbor id
+         * @param key the non-agreement key of {u,v}
+         */
+        void insert(unsigned long v, unsigned long u, na_key_t key);
+        /**
+         * @brief updates the non-agreements of entries which are already in
+         * NAO(v), in place; it never moves a range, so it can be called in
+         * parallel for distinct vertices
+         *
+         * @param v vertex id
+         * @param changes pairs of distinct neighbors u of v and their new non-agreement key
+         */
+        void update_existing(unsigned long v, const std::vector<std::pair<unsigned long, na_key_t>> &changes);
+        /**
+         * @brief removes the entry of u from NAO(v), if any
+         *
+         * @param v vertex id
+         * @param u neighbor id
+         */
+        void remove(unsigned long v, unsigned long u);
+        /**
+         * @brief replaces NAO(v) by the given entries
+         *
+         * @param v vertex id
+         * @param entries pairs of neighbor and non-agreement key, in any order
+         */
+        void assign(unsigned long v, const std::vector<std::pair<unsigned long, na_key_t>> &entries);
+        /**
+         * @brief adds a new vertex id with an empty NAO
+         *
+         * @return unsigned long the new vertex id, which is get_n() before the call
+         */
+        unsigned long add_vertex();
+        /**
+         * @brief removes NAO(v); the entries of v in the NAOs of its
+         * neighbors are not touched
+         *
+         * @param v vertex id
+         */
+        void remove_vertex(unsigned long v);
+        /**
+         * @brief repacks all NAOs in vertex order with fresh slack,
+         * dropping the abandoned ranges
+         *
+         */
+        void compact();
+        /**
+         * @brief renumbers the NAOs and the ids in them by a compaction of
+         * the vertex ids, see Graph::compact_ids, repacking them in the new
+         * vertex order with fresh slack
+         * @note no NAO should have an entry of a removed vertex; the
+         * renumbering is increasing, so the ties of the keys stay sorted by id
+         *
+         * @param old_to_new the new id of every vertex id, REMOVED_VERTEX_ID for the removed ones
+         */
+        void compact_ids(const std::vector<unsigned long> *old_to_new);
+        /**
+         * @brief returns the entries of NAO(v) as (neighbor, non-agreement) pairs, for reporting
+         *
+         * @param v vertex id
+         * @return std::vector<std::pair<unsigned long, double>>
+         */
+        std::vector<std::pair<unsigned long, double>> entries(unsigned long v) const;
+        /**
+         * @brief the number of bytes allocated by the arena
+         *
+         * @return unsigned long
+         */
+        unsigned long memory_bytes() const;
+};
+
+#endif // NAO_ARENA_H_
@@ -1,81 +1,64 @@
 #include "NaiveCorrelationClustering.h"
+#include "Stats.h"
 
 NaiveCorrelationClustering::NaiveCorrelationClustering(Graph *g) {
     this->g = new Graph(g);
     this->original_g = g;
+    this->csr = new GraphCSR(this->g);
+    this->owns_csr = true;
+}
+
+NaiveCorrelationClustering::NaiveCorrelationClustering(GraphCSR *g) {
+    this->g = nullptr;
+    this->original_g = nullptr;
+    this->csr = g;
+    this->owns_csr = false;
 }
 
 void NaiveCorrelationClustering::reset_g() {
-    this->g = new Graph(g);
+    if (this->g == nullptr)
+        return; // running directly on a snapshot, nothing to reset
+    auto old_g = this->g;
+    this->g = new Graph(old_g);
+    delete old_g;
+    if (this->owns_csr) {
+        delete this->csr;
+        this->csr = new GraphCSR(this->g);
+    }
 }
 
 NaiveCorrelationClustering::~NaiveCorrelationClustering() {
     delete this->g;
+    if (this->owns_csr)
+        delete this->csr;
 }
 
 std::vector<unsigned long>* NaiveCorrelationClustering::query(double eps) {
-    auto n = this->g->get_n();
-    if (this->g_temp)
-        delete this->g_temp;
-    this->g_temp = new Graph(this->original_g);
-    this->remove_non_agree_edges_and_light(eps);
-    return this->connected_components();
-}
-
-std::vector<unsigned long>* NaiveCorrelationClustering::connected_components() {
-    // finding connected components
-    auto assignment = new std::vector<unsigned long>(this->g->get_n(), -1);
-    auto visited = new std::vector<bool>(this->g->get_n(), false);
-    unsigned long cluster_id = 1ul;
-    auto *stack = new std::stack<unsigned long>();
-    unsigned long remaining_vertices = this->g->get_n();
-    stack->push(0); // starting vertex is 0
-    while(remaining_vertices > 0) {
-        // performing a DFS
-        while(! stack->empty()) {
-            auto vertex = stack->top();
-            stack->pop();
-            if (! visited->at(vertex)) {
-                (*visited)[vertex] = true;
-                remaining_vertices--;
-                (*assignment)[vertex] = cluster_id;
-                for(auto neigh: *(this->g_temp->get_neighborhood(vertex))) {
-                    if (! visited->at(neigh)) {
-                        stack->push(neigh);
-                    }
-                }
-            }
-            // else { it is processed }
-        }
-        // find the next vertex
-        for(unsigned long i = 0ul; i < this->g_temp->get_n(); ++i) {
-            if (! (*visited)[i]) {
-                stack->push(i);
-                break;
-            }
-        }
-        if (! stack->empty()) {
-            cluster_id++;
-            assert(remaining_vertices > 0);
-        }
-    }
-    delete visited;
-    delete stack;
+    PhaseTimer timer(PHASE_NAIVE_QUERY);
+    auto uf = new UnionFind(this->csr->get_n());
+    this->unite_surviving_edges(eps, uf);
+    auto assignment = uf->labels();
+    delete uf;
     return assignment;
 }
 
-void NaiveCorrelationClustering::remove_non_agree_edges_and_light(double eps) {
+void NaiveCorrelationClustering::unite_surviving_edges(double eps, UnionFind *uf) {
     // identifying all edges which are in non-eps agreement
-    auto non_agree_edges = new std::vector<std::pair<unsigned long, unsigned long>>();
-    auto eps_agree_cnt = new std::vector<unsigned long>(this->g->get_n(), 0);
-    auto is_light = new std::vector<bool>(this->g->get_n(), false);
+    auto n = this->csr->get_n();
+    auto eps_agree_cnt = new std::vector<vertex_id_t>(n, 0);
+    auto is_light = new std::vector<bool>(n, false);
+    auto support = new EdgeSupport(this->csr);
+    auto eps_key = eps_to_key(eps);
+    auto live = this->csr->get_live_vertices();
+    unsigned long non_agree_edges = 0ul, light_edges = 0ul, light_vertices = 0ul;
     // counting the # of e-agreement positive edges
-    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
-        for(auto j: *(this->g->get_neighborhood(i))) {
+    live->for_each([&](unsigned long i) {
+        for(auto slot = this->csr->get_offset(i); slot < this->csr->get_offset(i + 1); ++slot) {
+            auto j = this->csr->neighbor_at(slot);
             // as the edges are undirected, you need to consider one side
             if (j > i) {
-                if (this->g->non_agreement(i, j) >= eps) {
-                    non_agree_edges->push_back(std::make_pair(i, j));
+                if (support->key_at(slot) >= eps_key) {
+                    non_agree_edges++;
                 }
                 else {
                     (*eps_agree_cnt)[i]++;
@@ -83,38 +66,32 @@ void NaiveCorrelationClustering::remove_non_agree_edges_and_light(double eps) {
                 }
             }
         }
-    }
+    });
     // identifying whether vertices are e-light or not
-    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
+    live->for_each([&](unsigned long i) {
         if (
-            (this->g->deg_positive(i) == 0) ||
-            (*eps_agree_cnt)[i] < eps * this->g->deg_positive(i)
+            (this->csr->deg_positive(i) == 0) ||
+            (*eps_agree_cnt)[i] < eps * this->csr->deg_positive(i)
         ) {
             (*is_light)[i] = true;
+            light_vertices++;
         }
-    }
-    // removing all non-agree edges
-    for(auto edge: *non_agree_edges) {
-        this->g_temp->remove_positive_edge(edge.first, edge.second);
-    }
-    std::cerr << "Naive: There are " << non_agree_edges->size() 
-        << " non-agree edges to delete." << std::endl;
-    // removing light vertices
-    delete non_agree_edges;
-    non_agree_edges = new std::vector<std::pair<unsigned long, unsigned long>>();
-    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
-        for(auto j: *(this->g->get_neighborhood(i))) {
-            if ((*is_light)[i] && (*is_light)[j]) {
-                non_agree_edges->push_back(std::make_pair(i,j));
+    });
+    // keeping the e-agreement edges which are not between two light vertices
+    live->for_each([&](unsigned long i) {
+        for(auto slot = this->csr->get_offset(i); slot < this->csr->get_offset(i + 1); ++slot) {
+            auto j = this->csr->neighbor_at(slot);
+            if (j > i && support->key_at(slot) < eps_key) {
+                if ((*is_light)[i] && (*is_light)[j])
+                    light_edges++;
+                else
+                    uf->unite(i, j);
             }
         }
-    }
-    std::cerr << "Naive: There are " << non_agree_edges->size() 
-        << " light edges to delete." << std::endl;
-    for(auto edge: *non_agree_edges) {
-        this->g_temp->remove_positive_edge(edge.first, edge.second);
-    }
+    });
+    stat_add(STAT_EDGES_PRUNED, non_agree_edges + light_edges);
+    stat_add(STAT_LIGHT_VERTICES, light_vertices);
+    delete support;
     delete is_light;
     delete eps_agree_cnt;
-    delete non_agree_edges;
 }
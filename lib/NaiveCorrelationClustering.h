@@ -9,28 +9,29 @@
 
 #ifndef NAIVE_CORRELATION_CLUSTERING_H_
 #define NAIVE_CORRELATION_CLUSTERING_H_
-#include <stack>
 #include <cassert>
 #include "Graph.h"
+#include "GraphCSR.h"
+#include "EdgeSupport.h"
+#include "UnionFind.h"
 
 class NaiveCorrelationClustering {
     protected:
         Graph *g;
-        Graph *g_temp;
         const Graph *original_g;
+        GraphCSR *csr;
+        ///< read-optimized snapshot of g which all the queries run against
+        bool owns_csr;
+        ///< true iff csr is built (and should be freed) by this object
         /**
-         * @brief removes all non-agreement edges from g
+         * @brief unites the endpoints of every positive edge which survives
+         * the pruning for eps, i.e. every edge in eps-agreement whose
+         * endpoints are not both eps-light; the pruned graph is never built
          * 
          * @param eps 
+         * @param uf the union-find over the vertices of g
          */
-        void remove_non_agree_edges_and_light(double eps);
-        /**
-         * @brief compuetes the connected components of the graph
-         * and return it, the cluster numebrs start at 1
-         * 
-         * @return std::vector<unsigned long>* cluster assignment function starting at 1
-         */
-        std::vector<unsigned long>* connected_components();
+        void unite_surviving_edges(double eps, UnionFind *uf);
     public:
         /**
          * @brief Construct a new Naive Correlation Clustering object
@@ -38,6 +39,13 @@ class NaiveCorrelationClustering {
          * @param g input graph
          */
         NaiveCorrelationClustering(Graph *g);
+        /**
+         * @brief Construct a new Naive Correlation Clustering object directly
+         * on a CSR snapshot, without keeping a dynamic Graph (get_g() is nullptr)
+         * 
+         * @param g input graph snapshot, which should outlive this object
+         */
+        NaiveCorrelationClustering(GraphCSR *g);
         /**
          * @brief Destroy the Naive Correlation Clustering object
          * 
@@ -52,7 +60,7 @@ class NaiveCorrelationClustering {
          */
         std::vector<unsigned long>* query(double eps);
         /**
-         * @brief copies the graph original_g to g
+         * @brief copies the graph original_g to g and refreshes the snapshot
          * 
          */
         void reset_g();
@@ -0,0 +1,105 @@
+/**
+ * @file NonAgreement.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Exact integer keys for non-agreements, and the thresholds of eps in the same scale
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef NON_AGREEMENT_H_
+#define NON_AGREEMENT_H_
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+
+typedef std::uint64_t na_key_t;
+///< @note a non-agreement x as the integer floor(x * 2^NA_KEY_FRACTION_BITS)
+
+const unsigned int NA_KEY_FRACTION_BITS = 62u;
+///< @note a non-agreement is in [0, 2), so its key is below 2^63
+const unsigned long NA_KEY_MAX_DENOMINATOR = 1ul << (NA_KEY_FRACTION_BITS / 2);
+///< @note two distinct fractions with denominators up to this differ by at least
+///< 2^-NA_KEY_FRACTION_BITS, so their keys differ, i.e., keys are exact up to this degree
+const na_key_t NA_KEY_ALL = na_key_t(1) << (NA_KEY_FRACTION_BITS + 1);
+///< @note above the key of every non-agreement
+const na_key_t NA_KEY_INVALID = std::numeric_limits<na_key_t>::max();
+///< @note the key of a pair of vertices which is not a positive edge
+
+/**
+ * @brief the key of the non-agreement num/den
+ * @details NonAgreement(u,v) = (deg_u + deg_v - 2 |common|) / (max(deg_u, deg_v) + 1)
+ * is a fraction of small integers, so it is kept as this fixed-point integer
+ * instead of a double: equal fractions get equal keys, and for denominators
+ * up to NA_KEY_MAX_DENOMINATOR distinct fractions get distinct keys in the
+ * same order, so keys are compared, sorted and deduplicated as integers.
+ *
+ * @param num numerator, below 2 den
+ * @param den denominator, positive
+ * @return na_key_t
+ */
+inline na_key_t na_key(unsigned long num, unsigned long den) {
+    return static_cast<na_key_t>((static_cast<unsigned __int128>(num) << NA_KEY_FRACTION_BITS) / den);
+}
+
+/**
+ * @brief the key of NonAgreement(u,v) from the degrees and the common neighbors
+ *
+ * @param deg_u |N^+(u)|
+ * @param deg_v |N^+(v)|
+ * @param common |N^+(u) \cap N^+(v)|
+ * @return na_key_t
+ */
+inline na_key_t non_agreement_key(unsigned long deg_u, unsigned long deg_v, unsigned long common) {
+    return na_key(deg_u + deg_v - 2 * common, ((deg_u > deg_v) ? deg_u : deg_v) + 1);
+}
+
+/**
+ * @brief the non-agreement of a key as a double, for reporting
+ * @details The fraction x of the key lies in [key, key + 1) / 2^NA_KEY_FRACTION_BITS,
+ * and for x >= 2^-9 every rounding boundary of a double in that scale is an
+ * integer, so rounding key + 1/2 gives exactly the double nearest to x, the
+ * same value as computing the fraction in floating point. Below that, other
+ * than for 0, it may be off in the last bits, as the key has no more precision.
+ *
+ * @param key a non-agreement key other than NA_KEY_INVALID
+ * @return double
+ */
+inline double na_key_to_double(na_key_t key) {
+    if (key == 0u)
+        return 0.0;
+    return std::ldexp(static_cast<double>(2 * key + 1), -static_cast<int>(NA_KEY_FRACTION_BITS) - 1);
+}
+
+/**
+ * @brief the threshold key of eps: for every non-agreement x of key k,
+ * k < eps_to_key(eps) iff x, rounded to the nearest double, is below eps
+ * @details These are the non-agreements below the midpoint of eps and the
+ * double before it, so the threshold is that midpoint in the key scale,
+ * rounded up. For eps > 2^-9 the midpoint is an integer in this scale and
+ * the threshold is exact, so an eps is rounded once per query and the
+ * comparisons against keys are integer only, with the same outcome as
+ * comparing the doubles. Below that the keys are coarser than the doubles,
+ * and a non-agreement within 2^-NA_KEY_FRACTION_BITS of eps may compare
+ * either way; all the engines use the keys, so they still agree.
+ *
+ * @param eps parameter eps
+ * @return na_key_t
+ */
+inline na_key_t eps_to_key(double eps) {
+    if (!(eps > 0.0))
+        return 0u;
+    if (eps >= 2.0)
+        return NA_KEY_ALL;
+    auto below = std::nextafter(eps, 0.0);
+    const int half_scale = static_cast<int>(NA_KEY_FRACTION_BITS) - 1;
+    const double half_unit = static_cast<double>(na_key_t(1) << half_scale);
+    //< scaling by a power of 2 is exact
+    if (eps > std::ldexp(1.0, -9))
+        return static_cast<na_key_t>(below * half_unit) + static_cast<na_key_t>(eps * half_unit);
+    long double mid = std::ldexp(static_cast<long double>(below) + static_cast<long double>(eps), half_scale);
+    return static_cast<na_key_t>(std::ceil(mid));
+}
+
+#endif // NON_AGREEMENT_H_
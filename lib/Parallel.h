@@ -0,0 +1,228 @@
+/**
+ * @file Parallel.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Small std::thread based helpers for data-parallel loops and sorting
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+
+/**
+ * @brief resolves the number of worker threads to use
+ *
+ * @param num_threads requested number of threads, 0 means all hardware threads
+ * @return unsigned int the effective number of threads (at least 1)
+ */
+inline unsigned int resolve_num_threads(unsigned int num_threads) {
+    if (num_threads == 0u)
+        num_threads = std::thread::hardware_concurrency();
+    return (num_threads == 0u) ? 1u : num_threads;
+}
+
+/**
+ * @brief runs fn(i) for all i in [begin, end) by splitting the range into
+ * num_threads contiguous blocks of equal length
+ *
+ * @param begin first index
+ * @param end one past the last index
+ * @param fn the loop body, called as fn(i)
+ * @param num_threads number of threads, 0 means all hardware threads
+ */
+template<typename F>
+void parallel_for(unsigned long begin, unsigned long end, F fn, unsigned int num_threads = 0u) {
+    if (end <= begin)
+        return;
+    unsigned long len = end - begin;
+    unsigned long threads = std::min<unsigned long>(resolve_num_threads(num_threads), len);
+    if (threads == 1ul) {
+        for(unsigned long i = begin; i < end; ++i)
+            fn(i);
+        return;
+    }
+    std::vector<std::thread> workers;
+    unsigned long block = (len + threads - 1) / threads;
+    for(unsigned long t = 0ul; t < threads; ++t) {
+        unsigned long lo = begin + t * block;
+        unsigned long hi = std::min(end, lo + block);
+        if (lo >= hi)
+            break;
+        workers.emplace_back([lo, hi, &fn]() {
+            for(unsigned long i = lo; i < hi; ++i)
+                fn(i);
+        });
+    }
+    for(auto &w: workers)
+        w.join();
+}
+
+/**
+ * @brief runs fn(i, t) for all i in [0, n) where the cost of fn(i, t) is
+ * proportional to weight(i) and t < num_threads is the index of the worker
+ * thread running it, e.g. to address per-thread scratch space
+ * @details The range is cut into about CHUNKS_PER_THREAD * num_threads chunks
+ * of (roughly) equal total weight; the threads repeatedly grab the next
+ * unprocessed chunk, so a few heavy items cannot leave one thread as the
+ * straggler while the others are idle. An item heavier than a chunk forms a
+ * chunk on its own.
+ *
+ * @param n number of items
+ * @param weight the cost estimate, called as weight(i)
+ * @param fn the loop body, called as fn(i, t)
+ * @param num_threads number of threads, 0 means all hardware threads
+ */
+template<typename W, typename F>
+void parallel_for_weighted_indexed(unsigned long n, W weight, F fn, unsigned int num_threads = 0u) {
+    const unsigned long CHUNKS_PER_THREAD = 16ul;
+    unsigned long threads = std::min<unsigned long>(resolve_num_threads(num_threads), n);
+    if (threads <= 1ul) {
+        for(unsigned long i = 0ul; i < n; ++i)
+            fn(i, 0u);
+        return;
+    }
+    long double total = 0;
+    for(unsigned long i = 0ul; i < n; ++i)
+        total += weight(i);
+    long double chunk_weight = total / (CHUNKS_PER_THREAD * threads);
+    std::vector<unsigned long> bounds = {0ul};
+    long double acc = 0;
+    for(unsigned long i = 0ul; i < n; ++i) {
+        acc += weight(i);
+        if (acc >= chunk_weight) {
+            bounds.push_back(i + 1);
+            acc = 0;
+        }
+    }
+    if (bounds.back() != n)
+        bounds.push_back(n);
+    std::atomic<unsigned long> next_chunk(0ul);
+    std::vector<std::thread> workers;
+    for(unsigned long t = 0ul; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            unsigned long c;
+            while ((c = next_chunk.fetch_add(1ul)) + 1 < bounds.size()) {
+                for(unsigned long i = bounds[c]; i < bounds[c + 1]; ++i)
+                    fn(i, static_cast<unsigned int>(t));
+            }
+        });
+    }
+    for(auto &w: workers)
+        w.join();
+}
+
+/**
+ * @brief runs fn(i) for all i in [0, n) where the cost of fn(i) is proportional
+ * to weight(i)
+ *
+ * @see parallel_for_weighted_indexed
+ */
+template<typename W, typename F>
+void parallel_for_weighted(unsigned long n, W weight, F fn, unsigned int num_threads = 0u) {
+    parallel_for_weighted_indexed(n, weight, [&fn](unsigned long i, unsigned int) { fn(i); }, num_threads);
+}
+
+/**
+ * @brief sorts [first, last) by sorting num_threads blocks concurrently and
+ * then merging neighbouring blocks pairwise, also concurrently
+ *
+ * @param first random access iterator to the first element
+ * @param last random access iterator past the last element
+ * @param cmp the strict weak ordering
+ * @param num_threads number of threads, 0 means all hardware threads
+ */
+template<typename It, typename Cmp>
+void parallel_sort(It first, It last, Cmp cmp, unsigned int num_threads = 0u) {
+    unsigned long len = last - first;
+    unsigned long threads = resolve_num_threads(num_threads);
+    if (threads == 1ul || len < 2 * 4096ul) {
+        std::sort(first, last, cmp);
+        return;
+    }
+    unsigned long block = (len + threads - 1) / threads;
+    std::vector<unsigned long> bounds;
+    for(unsigned long lo = 0ul; lo < len; lo += block)
+        bounds.push_back(lo);
+    bounds.push_back(len);
+    parallel_for(0ul, bounds.size() - 1, [&](unsigned long b) {
+        std::sort(first + bounds[b], first + bounds[b + 1], cmp);
+    }, threads);
+    // merging the sorted runs pairwise until a single run remains
+    while (bounds.size() > 2) {
+        std::vector<unsigned long> merged;
+        unsigned long runs = bounds.size() - 1;
+        parallel_for(0ul, runs / 2, [&](unsigned long r) {
+            std::inplace_merge(first + bounds[2 * r], first + bounds[2 * r + 1],
+                first + bounds[2 * r + 2], cmp);
+        }, threads);
+        for(unsigned long b = 0ul; b < bounds.size(); b += 2)
+            merged.push_back(bounds[b]);
+        if (merged.back() != len)
+            merged.push_back(len);
+        bounds.swap(merged);
+    }
+}
+
+/**
+ * @brief sorts items stably by an unsigned integer key, by a least
+ * significant digit radix sort whose passes are parallel
+ * @details Every pass splits the items into num_threads contiguous blocks;
+ * each thread counts the digits of its block, the counts give every
+ * (digit, block) pair its own output range, and each thread scatters its
+ * block in order, so the sort is stable. A pass on which all the keys have
+ * the same digit is skipped, so keys of few significant bits cost few passes.
+ *
+ * @param items the items, sorted in place
+ * @param key the key of an item, called as key(item), returning an unsigned 64-bit integer
+ * @param num_threads number of threads, 0 means all hardware threads
+ */
+template<typename T, typename K>
+void parallel_radix_sort(std::vector<T> &items, K key, unsigned int num_threads = 0u) {
+    const unsigned int RADIX_BITS = 11u;
+    const unsigned long BUCKETS = 1ul << RADIX_BITS;
+    unsigned long len = items.size();
+    unsigned long threads = std::max<unsigned long>(1ul,
+        std::min<unsigned long>(resolve_num_threads(num_threads), len / 4096ul));
+    unsigned long block = (len + threads - 1) / threads;
+    std::vector<T> buffer(len);
+    std::vector<std::vector<unsigned long>> counts(threads, std::vector<unsigned long>(BUCKETS));
+    for(unsigned int shift = 0u; shift < 64u; shift += RADIX_BITS) {
+        auto digit = [&](const T &item) {
+            return static_cast<unsigned long>((key(item) >> shift) & (BUCKETS - 1));
+        };
+        parallel_for(0ul, threads, [&](unsigned long t) {
+            std::fill(counts[t].begin(), counts[t].end(), 0ul);
+            for(unsigned long i = t * block; i < std::min(len, (t + 1) * block); ++i)
+                counts[t][digit(items[i])]++;
+        }, threads);
+        // turning the counts into the first output position of every (digit, block)
+        unsigned long offset = 0ul;
+        bool single_digit = false;
+        for(unsigned long d = 0ul; d < BUCKETS; ++d) {
+            unsigned long start = offset;
+            for(unsigned long t = 0ul; t < threads; ++t) {
+                auto c = counts[t][d];
+                counts[t][d] = offset;
+                offset += c;
+            }
+            if (offset - start == len)
+                single_digit = true;
+        }
+        if (single_digit)
+            continue;
+        parallel_for(0ul, threads, [&](unsigned long t) {
+            auto &next = counts[t];
+            for(unsigned long i = t * block; i < std::min(len, (t + 1) * block); ++i)
+                buffer[next[digit(items[i])]++] = items[i];
+        }, threads);
+        items.swap(buffer);
+    }
+}
+
+#endif // PARALLEL_H_
@@ -0,0 +1,193 @@
+/**
+ * @file PositionIndex.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief A compact hash from neighbor ids to their positions inside a NAO
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef POSITION_INDEX_H_
+#define POSITION_INDEX_H_
+
+#include <vector>
+#include <limits>
+
+/**
+ * @brief Maps the neighbor ids of one NAO to their positions in it, with
+ * open addressing and linear probing over two aligned arrays.
+ * @details A NAO is sorted by non-agreement, not by id, so finding a
+ * neighbor would otherwise be a scan of the whole NAO. The owner calls set
+ * for every entry that moves, hence keeping the index correct costs as much
+ * as the move itself, while a lookup is O(1) expected. Erasing uses
+ * backward shifting, so there are no tombstones and probes stay short.
+ *
+ * @tparam T an unsigned integer type for both the ids and the positions
+ */
+template<typename T>
+class PositionIndex {
+    protected:
+        std::vector<T> *ids;
+        ///< the id in each bucket, or EMPTY
+        std::vector<T> *positions;
+        ///< the position of the id in each bucket
+        unsigned long count;
+        ///< the number of ids
+        unsigned long mask;
+        ///< the number of buckets minus 1, a power of 2 minus 1
+        static const T EMPTY = std::numeric_limits<T>::max();
+        ///< marks an empty bucket, so this id cannot be stored
+        /**
+         * @brief the home bucket of id, by Fibonacci hashing
+         *
+         * @param id neighbor id
+         * @return unsigned long
+         */
+        unsigned long home(T id) const {
+            return (static_cast<unsigned long>(id) * 0x9E3779B97F4A7C15ul >> 17) & this->mask;
+        };
+        /**
+         * @brief the bucket of id, or the empty bucket where it would be inserted
+         *
+         * @param id neighbor id
+         * @return unsigned long
+         */
+        unsigned long bucket_of(T id) const {
+            auto b = this->home(id);
+            while ((*this->ids)[b] != EMPTY && (*this->ids)[b] != id)
+                b = (b + 1) & this->mask;
+            return b;
+        };
+        /**
+         * @brief reallocates the buckets so that size ids take at most half of them
+         *
+         * @param size the number of ids to make room for
+         */
+        void grow(unsigned long size) {
+            unsigned long buckets = 8ul;
+            while (buckets < 2 * size)
+                buckets *= 2;
+            auto old_ids = this->ids;
+            auto old_positions = this->positions;
+            this->ids = new std::vector<T>(buckets, EMPTY);
+            this->positions = new std::vector<T>(buckets);
+            this->mask = buckets - 1;
+            for(unsigned long b = 0ul; b < old_ids->size(); ++b) {
+                if ((*old_ids)[b] != EMPTY) {
+                    auto nb = this->bucket_of((*old_ids)[b]);
+                    (*this->ids)[nb] = (*old_ids)[b];
+                    (*this->positions)[nb] = (*old_positions)[b];
+                }
+            }
+            delete old_ids;
+            delete old_positions;
+        };
+    public:
+        static const unsigned long NOT_FOUND = std::numeric_limits<unsigned long>::max();
+        ///< returned by find for an absent id
+        /**
+         * @brief Construct a new empty PositionIndex object
+         *
+         * @param expected the number of ids to make room for
+         */
+        PositionIndex(unsigned long expected = 0ul) {
+            this->ids = new std::vector<T>();
+            this->positions = new std::vector<T>();
+            this->count = 0ul;
+            this->grow(expected);
+        };
+        /**
+         * @brief Destroy the PositionIndex object
+         *
+         */
+        ~PositionIndex() {
+            delete this->ids;
+            delete this->positions;
+        };
+        PositionIndex(const PositionIndex &) = delete;
+        PositionIndex &operator=(const PositionIndex &) = delete;
+        /**
+         * @brief the position of id, or NOT_FOUND
+         *
+         * @param id neighbor id
+         * @return unsigned long
+         */
+        unsigned long find(T id) const {
+            auto b = this->bucket_of(id);
+            return ((*this->ids)[b] == EMPTY) ? NOT_FOUND : (*this->positions)[b];
+        };
+        /**
+         * @brief sets the position of id, adding id if absent
+         *
+         * @param id neighbor id
+         * @param position its position in the NAO
+         */
+        void set(T id, T position) {
+            auto b = this->bucket_of(id);
+            if ((*this->ids)[b] == EMPTY) {
+                if (2 * (this->count + 1) > this->ids->size()) {
+                    this->grow(this->count + 1);
+                    b = this->bucket_of(id);
+                }
+                (*this->ids)[b] = id;
+                this->count++;
+            }
+            (*this->positions)[b] = position;
+        };
+        /**
+         * @brief removes id, if present
+         *
+         * @param id neighbor id
+         */
+        void erase(T id) {
+            auto b = this->bucket_of(id);
+            if ((*this->ids)[b] == EMPTY)
+                return;
+            // shifting back the following ids of the cluster which may not
+            // stay behind the hole, so every probe still reaches its id
+            auto hole = b;
+            for(auto next = (hole + 1) & this->mask; (*this->ids)[next] != EMPTY; next = (next + 1) & this->mask) {
+                auto h = this->home((*this->ids)[next]);
+                if (((next - h) & this->mask) >= ((next - hole) & this->mask)) {
+                    (*this->ids)[hole] = (*this->ids)[next];
+                    (*this->positions)[hole] = (*this->positions)[next];
+                    hole = next;
+                }
+            }
+            (*this->ids)[hole] = EMPTY;
+            this->count--;
+        };
+        /**
+         * @brief removes all the ids, keeping room for expected ones
+         *
+         * @param expected the number of ids to make room for
+         */
+        void clear(unsigned long expected = 0ul) {
+            this->ids->clear();
+            this->positions->clear();
+            this->count = 0ul;
+            this->grow(expected);
+        };
+        /**
+         * @brief the number of ids
+         *
+         * @return unsigned long
+         */
+        unsigned long size() const { return this->count; };
+        /**
+         * @brief the number of bytes allocated by the index
+         *
+         * @return unsigned long
+         */
+        unsigned long memory_bytes() const {
+            return sizeof(PositionIndex) + (this->ids->capacity() + this->positions->capacity()) * sizeof(T);
+        };
+};
+
+template<typename T>
+const T PositionIndex<T>::EMPTY;
+
+template<typename T>
+const unsigned long PositionIndex<T>::NOT_FOUND;
+
+#endif // POSITION_INDEX_H_
@@ -0,0 +1,98 @@
+#include "Stats.h"
+#include <atomic>
+#include <iomanip>
+
+static std::atomic<unsigned long> global_counters[STAT_NUM_COUNTERS];
+///< the counters of the exited threads
+static std::atomic<unsigned long> global_phase_ns[STAT_NUM_PHASES];
+///< the phase times of the exited threads
+static std::atomic<unsigned long> global_phase_calls[STAT_NUM_PHASES];
+///< the phase calls of the exited threads
+
+ThreadStats::~ThreadStats() {
+    for(unsigned int c = 0u; c < STAT_NUM_COUNTERS; ++c)
+        global_counters[c].fetch_add(this->counters[c], std::memory_order_relaxed);
+    for(unsigned int p = 0u; p < STAT_NUM_PHASES; ++p) {
+        global_phase_ns[p].fetch_add(this->phase_ns[p], std::memory_order_relaxed);
+        global_phase_calls[p].fetch_add(this->phase_calls[p], std::memory_order_relaxed);
+    }
+}
+
+StatsSnapshot stats_snapshot() {
+    StatsSnapshot snapshot = thread_stats();
+    for(unsigned int c = 0u; c < STAT_NUM_COUNTERS; ++c)
+        snapshot.counters[c] += global_counters[c].load(std::memory_order_relaxed);
+    for(unsigned int p = 0u; p < STAT_NUM_PHASES; ++p) {
+        snapshot.phase_ns[p] += global_phase_ns[p].load(std::memory_order_relaxed);
+        snapshot.phase_calls[p] += global_phase_calls[p].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void stats_reset() {
+    auto &stats = thread_stats();
+    for(unsigned int c = 0u; c < STAT_NUM_COUNTERS; ++c) {
+        global_counters[c].store(0ul, std::memory_order_relaxed);
+        stats.counters[c] = 0ul;
+    }
+    for(unsigned int p = 0u; p < STAT_NUM_PHASES; ++p) {
+        global_phase_ns[p].store(0ul, std::memory_order_relaxed);
+        global_phase_calls[p].store(0ul, std::memory_order_relaxed);
+        stats.phase_ns[p] = 0ul;
+        stats.phase_calls[p] = 0ul;
+    }
+}
+
+const char* stat_counter_name(StatCounter counter) {
+    switch (counter) {
+        case STAT_INTERSECTIONS: return "intersections";
+        case STAT_NAO_ENTRIES_SCANNED: return "nao_entries_scanned";
+        case STAT_EDGES_PRUNED: return "edges_pruned";
+        case STAT_LIGHT_VERTICES: return "light_vertices";
+        case STAT_UNIONS: return "unions";
+        case STAT_UPDATES_APPLIED: return "updates_applied";
+        default: return "unknown";
+    }
+}
+
+const char* stat_phase_name(StatPhase phase) {
+    switch (phase) {
+        case PHASE_LOAD: return "load";
+        case PHASE_EDGE_SUPPORT: return "edge_support";
+        case PHASE_NAO_BUILD: return "nao_build";
+        case PHASE_EDGE_ORDER: return "edge_order";
+        case PHASE_NAO_REPAIR: return "nao_repair";
+        case PHASE_UPDATE: return "update";
+        case PHASE_COMPACTION: return "compaction";
+        case PHASE_NAIVE_QUERY: return "naive_query";
+        case PHASE_INDEX_QUERY: return "index_query";
+        case PHASE_HIERARCHICAL_QUERY: return "hierarchical_query";
+        case PHASE_LABELS: return "labels";
+        case PHASE_CLUSTERING_COST: return "clustering_cost";
+        default: return "unknown";
+    }
+}
+
+void write_stats_json(std::ostream &out, std::string run) {
+    auto stats = stats_snapshot();
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << "{\n  \"run\": \"" << run << "\",\n  \"counters\": {";
+    for(unsigned int c = 0u; c < STAT_NUM_COUNTERS; ++c) {
+        out << (c ? ",\n" : "\n") << "    \"" << stat_counter_name(static_cast<StatCounter>(c)) << "\": "
+            << stats.counters[c];
+    }
+    out << "\n  },\n  \"phases\": {";
+    bool first = true;
+    for(unsigned int p = 0u; p < STAT_NUM_PHASES; ++p) {
+        if (stats.phase_calls[p] == 0ul)
+            continue;
+        out << (first ? "\n" : ",\n") << "    \"" << stat_phase_name(static_cast<StatPhase>(p))
+            << "\": {\"calls\": " << stats.phase_calls[p] << ", \"ms\": "
+            << std::fixed << std::setprecision(3) << stats.phase_ns[p] / 1e6 << "}";
+        first = false;
+    }
+    out << (first ? "" : "\n  ") << "}\n}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
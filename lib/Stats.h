@@ -0,0 +1,178 @@
+/**
+ * @file Stats.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Low-overhead per-thread counters and scoped phase timers, exported as JSON
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef STATS_H_
+#define STATS_H_
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief the counters of the hot paths
+ *
+ */
+enum StatCounter {
+    STAT_INTERSECTIONS,         ///< the common-neighbor counts computed, by a merge or a marker scan
+    STAT_NAO_ENTRIES_SCANNED,   ///< the entries of the NAOs and of the edge order read by the queries
+    STAT_EDGES_PRUNED,          ///< the positive edges deleted by the queries, non-agreeing or between light vertices
+    STAT_LIGHT_VERTICES,        ///< the eps-light vertices found by the queries
+    STAT_UNIONS,                ///< the union-find unions of the connected components, i.e., its iterations
+    STAT_UPDATES_APPLIED,       ///< the edge and vertex updates applied to the index
+    STAT_NUM_COUNTERS
+};
+
+/**
+ * @brief the phases timed by a PhaseTimer
+ *
+ */
+enum StatPhase {
+    PHASE_LOAD,                 ///< reading a graph into memory
+    PHASE_EDGE_SUPPORT,         ///< counting the triangles on every edge
+    PHASE_NAO_BUILD,            ///< building the NAOs of all the vertices
+    PHASE_EDGE_ORDER,           ///< sorting the edges by non-agreement
+    PHASE_NAO_REPAIR,           ///< repairing the NAOs after updates
+    PHASE_UPDATE,               ///< applying the updates to the index
+    PHASE_COMPACTION,           ///< renumbering the live vertices of the index
+    PHASE_NAIVE_QUERY,          ///< a query of the naive engine
+    PHASE_INDEX_QUERY,          ///< a query of the index-based engine
+    PHASE_HIERARCHICAL_QUERY,   ///< a query of a whole eps schedule
+    PHASE_LABELS,               ///< numbering the clusters of a union-find
+    PHASE_CLUSTERING_COST,      ///< evaluating the cost of a clustering
+    STAT_NUM_PHASES
+};
+
+/**
+ * @brief the counts and the phase times of a set of threads
+ *
+ */
+struct StatsSnapshot {
+    unsigned long counters[STAT_NUM_COUNTERS] = {};
+    ///< the counts
+    unsigned long phase_ns[STAT_NUM_PHASES] = {};
+    ///< the nanoseconds spent in every phase, nested phases included
+    unsigned long phase_calls[STAT_NUM_PHASES] = {};
+    ///< the number of times every phase was entered
+};
+
+/**
+ * @brief the statistics gathered by one thread, without any synchronization
+ * @note The statistics of a thread are added to the global ones when the
+ * thread exits, so the worker threads of the parallel loops, which are
+ * joined before a loop returns, are never lost.
+ */
+struct ThreadStats : public StatsSnapshot {
+    ThreadStats() = default;
+    ThreadStats(const ThreadStats &) = delete;
+    ThreadStats &operator=(const ThreadStats &) = delete;
+    /**
+     * @brief adds the statistics to the global ones
+     *
+     */
+    ~ThreadStats();
+};
+
+/**
+ * @brief the statistics of the calling thread
+ *
+ * @return ThreadStats&
+ */
+inline ThreadStats& thread_stats() {
+    thread_local ThreadStats stats;
+    return stats;
+}
+
+/**
+ * @brief adds count to a counter of the calling thread; compiled out with -DHCC_NO_STATS
+ *
+ * @param counter the counter
+ * @param count the amount
+ */
+inline void stat_add(StatCounter counter, unsigned long count = 1ul) {
+#ifndef HCC_NO_STATS
+    thread_stats().counters[counter] += count;
+#endif
+}
+
+/**
+ * @brief Times a phase from its construction to the end of its scope, in
+ * the statistics of the calling thread; compiled out with -DHCC_NO_STATS
+ *
+ */
+class PhaseTimer {
+#ifndef HCC_NO_STATS
+    protected:
+        StatPhase phase;
+        ///< the timed phase
+        std::chrono::steady_clock::time_point start;
+        ///< the time the phase was entered
+    public:
+        /**
+         * @brief enters the phase
+         *
+         * @param phase the timed phase
+         */
+        explicit PhaseTimer(StatPhase phase) : phase(phase), start(std::chrono::steady_clock::now()) {};
+        /**
+         * @brief leaves the phase
+         *
+         */
+        ~PhaseTimer() {
+            auto &stats = thread_stats();
+            stats.phase_ns[this->phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - this->start).count();
+            stats.phase_calls[this->phase]++;
+        };
+#else
+    public:
+        explicit PhaseTimer(StatPhase) {};
+#endif
+        PhaseTimer(const PhaseTimer &) = delete;
+        PhaseTimer &operator=(const PhaseTimer &) = delete;
+};
+
+/**
+ * @brief the statistics of the exited threads plus the calling thread
+ *
+ * @return StatsSnapshot
+ */
+StatsSnapshot stats_snapshot();
+
+/**
+ * @brief clears the statistics of the exited threads and of the calling thread
+ *
+ */
+void stats_reset();
+
+/**
+ * @brief the name of a counter, as used in the JSON output
+ *
+ * @param counter the counter
+ * @return const char*
+ */
+const char* stat_counter_name(StatCounter counter);
+
+/**
+ * @brief the name of a phase, as used in the JSON output
+ *
+ * @param phase the phase
+ * @return const char*
+ */
+const char* stat_phase_name(StatPhase phase);
+
+/**
+ * @brief writes stats_snapshot() as one JSON object with the name of the
+ * run, the counters, and the calls and milliseconds of every entered phase
+ *
+ * @param out the output stream
+ * @param run the name of the run
+ */
+void write_stats_json(std::ostream &out, std::string run);
+
+#endif // STATS_H_
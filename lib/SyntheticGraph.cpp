@@ -0,0 +1,324 @@
+#include "SyntheticGraph.h"
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+/**
+ * @brief the splitmix64 generator, a 64-bit random number per call
+ *
+ * @param state the state, advanced by the call
+ * @return unsigned long
+ */
+static inline unsigned long next_random(unsigned long &state) {
+    unsigned long z = (state += 0x9E3779B97F4A7C15ul);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ul;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBul;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief a uniform random double in (0, 1]
+ *
+ * @param state the state of next_random
+ * @return double
+ */
+static inline double next_uniform(unsigned long &state) {
+    return static_cast<double>((next_random(state) >> 11) + 1ul) * 0x1.0p-53;
+}
+
+/**
+ * @brief a uniform random number in [0, bound), by a multiply instead of a modulo
+ *
+ * @param state the state of next_random
+ * @param bound the number of values
+ * @return unsigned long
+ */
+static inline unsigned long next_below(unsigned long &state, unsigned long bound) {
+    return static_cast<unsigned long>((static_cast<unsigned __int128>(next_random(state)) * bound) >> 64);
+}
+
+/**
+ * @brief the initial state of the random stream of block b
+ *
+ * @param seed the seed of the graph
+ * @param b block index
+ * @return unsigned long
+ */
+static inline unsigned long block_state(unsigned long seed, unsigned long b) {
+    unsigned long state = seed ^ (b * 0xD1B54A32D192ED03ul);
+    return next_random(state);
+}
+
+/**
+ * @brief calls fn(i) for every i in [begin, end) independently with
+ * probability p, by skipping geometric gaps, in O(1 + number of calls)
+ *
+ * @param begin the first index
+ * @param end one past the last index
+ * @param p the probability of every index
+ * @param log_q log(1 - p)
+ * @param state the state of next_random
+ * @param fn called as fn(i) in increasing order of i
+ */
+template<typename F>
+static inline void for_each_bernoulli(unsigned long begin, unsigned long end, double p, double log_q,
+    unsigned long &state, F fn)
+{
+    if (p <= 0.0)
+        return;
+    if (p >= 1.0) {
+        for(unsigned long i = begin; i < end; ++i)
+            fn(i);
+        return;
+    }
+    for(unsigned long i = begin; i < end; ++i) {
+        double skip = std::floor(std::log(next_uniform(state)) / log_q);
+        if (skip >= static_cast<double>(end - i))
+            return;
+        i += static_cast<unsigned long>(skip);
+        fn(i);
+    }
+}
+
+unsigned long SyntheticGraph::cluster_begin(unsigned long c) const {
+    return static_cast<unsigned long>(static_cast<unsigned __int128>(c) * this->params.n / this->params.clusters);
+}
+
+unsigned long SyntheticGraph::cluster_of(unsigned long v) const {
+    if (this->params.model != PLANTED_PARTITION)
+        return 1ul;
+    // the largest c with cluster_begin(c) <= v, i.e., c * n < (v + 1) * clusters
+    return static_cast<unsigned long>((static_cast<unsigned __int128>(v + 1) * this->params.clusters - 1)
+        / this->params.n) + 1;
+}
+
+template<typename F>
+void SyntheticGraph::draw_block(unsigned long b, F fn) const {
+    unsigned long state = block_state(this->params.seed, b);
+    unsigned long n = this->params.n;
+    if (this->params.model == RMAT) {
+        unsigned long first = b * SYNTHETIC_BLOCK_EDGES;
+        unsigned long last = std::min(this->params.m, first + SYNTHETIC_BLOCK_EDGES);
+        unsigned int scale = 0u;
+        while ((1ul << scale) < n)
+            ++scale;
+        double ab = this->params.a + this->params.b, abc = ab + this->params.c;
+        for(unsigned long i = first; i < last; ++i) {
+            // the ids out of range and the self-loops are drawn again
+            while (true) {
+                unsigned long u = 0ul, v = 0ul;
+                for(unsigned int bit = 0u; bit < scale; ++bit) {
+                    double r = next_uniform(state);
+                    if (r > this->params.a && r <= ab)
+                        v |= 1ul << bit;
+                    else if (r > ab && r <= abc)
+                        u |= 1ul << bit;
+                    else if (r > abc) {
+                        u |= 1ul << bit;
+                        v |= 1ul << bit;
+                    }
+                }
+                if (u < n && v < n && u != v) {
+                    fn(std::min(u, v), std::max(u, v));
+                    break;
+                }
+            }
+        }
+        return;
+    }
+    double log_in = std::log1p(-this->params.p_in), log_out = std::log1p(-this->params.p_out);
+    unsigned long first = b * this->rows_per_block;
+    unsigned long last = std::min(n, first + this->rows_per_block);
+    unsigned long c = this->cluster_of(first);  //< the cluster of u, starting at 1
+    unsigned long end = this->cluster_begin(c);  //< the first vertex after the cluster of u
+    for(unsigned long u = first; u < last; ++u) {
+        if (u >= end)
+            end = this->cluster_begin(++c);
+        for_each_bernoulli(u + 1, end, this->params.p_in, log_in, state,
+            [&](unsigned long v) { fn(u, v); });
+        for_each_bernoulli(end, n, this->params.p_out, log_out, state,
+            [&](unsigned long v) { fn(u, v); });
+    }
+}
+
+SyntheticGraph::SyntheticGraph(const SyntheticGraphParams &params, unsigned int num_threads) {
+    this->params = params;
+    if (this->params.model != PLANTED_PARTITION)
+        this->params.clusters = 1ul;
+    if (this->params.model == ERDOS_RENYI)
+        this->params.p_out = 0.0;
+    auto is_probability = [](double p) { return p >= 0.0 && p <= 1.0; };
+    if (this->params.n == 0ul)
+        throw std::invalid_argument("A synthetic graph needs at least one vertex.");
+    if (this->params.clusters == 0ul || this->params.clusters > this->params.n)
+        throw std::invalid_argument("The number of clusters should be in [1, n].");
+    if (!is_probability(this->params.p_in) || !is_probability(this->params.p_out))
+        throw std::invalid_argument("The edge probabilities should be in [0, 1].");
+    if (this->params.model == RMAT && (this->params.n < 2ul || this->params.a < 0.0 ||
+            this->params.b < 0.0 || this->params.c < 0.0 ||
+            this->params.a + this->params.b + this->params.c > 1.0 ||
+            this->params.b + this->params.c <= 0.0))
+        throw std::invalid_argument("R-MAT needs n >= 2 and a, b, c >= 0 with a + b + c <= 1 and b + c > 0.");
+    unsigned long num_blocks;
+    if (this->params.model == RMAT) {
+        this->rows_per_block = 0ul;
+        num_blocks = (this->params.m + SYNTHETIC_BLOCK_EDGES - 1) / SYNTHETIC_BLOCK_EDGES;
+    }
+    else {
+        // as many rows as give SYNTHETIC_BLOCK_EDGES edges in expectation
+        double n = static_cast<double>(this->params.n);
+        double intra = n * (n / this->params.clusters - 1.0) / 2.0;
+        double expected = this->params.p_in * intra + this->params.p_out * (n * (n - 1.0) / 2.0 - intra);
+        double rows = (expected > 0.0) ? n * SYNTHETIC_BLOCK_EDGES / expected : n;
+        this->rows_per_block = static_cast<unsigned long>(std::max(1.0, std::min(n, rows)));
+        num_blocks = (this->params.n + this->rows_per_block - 1) / this->rows_per_block;
+    }
+    this->block_offsets = new std::vector<unsigned long>(num_blocks + 1, 0ul);
+    parallel_for(0ul, num_blocks, [&](unsigned long b) {
+        unsigned long count = 0ul;
+        this->draw_block(b, [&count](unsigned long, unsigned long) { ++count; });
+        (*this->block_offsets)[b + 1] = count;
+    }, num_threads);
+    std::partial_sum(this->block_offsets->begin(), this->block_offsets->end(), this->block_offsets->begin());
+}
+
+SyntheticGraph::~SyntheticGraph() {
+    delete this->block_offsets;
+}
+
+void SyntheticGraph::generate_block(unsigned long b, std::vector<std::pair<unsigned long, unsigned long>> *edges) const {
+    edges->reserve(edges->size() + (*this->block_offsets)[b + 1] - (*this->block_offsets)[b]);
+    this->draw_block(b, [edges](unsigned long u, unsigned long v) { edges->push_back(std::make_pair(u, v)); });
+}
+
+std::vector<std::pair<unsigned long, unsigned long>>* SyntheticGraph::sample_edges(unsigned long count,
+    unsigned long seed, unsigned int num_threads) const
+{
+    auto samples = new std::vector<std::pair<unsigned long, unsigned long>>(count);
+    if (count == 0ul)
+        return samples;
+    if (this->get_m() == 0ul) {
+        delete samples;
+        throw std::invalid_argument("The synthetic graph has no edges to sample.");
+    }
+    // (position in the edge stream, index of the sample), grouped by block
+    std::vector<std::pair<unsigned long, unsigned long>> positions(count);
+    unsigned long state = seed;
+    for(unsigned long i = 0ul; i < count; ++i)
+        positions[i] = std::make_pair(next_below(state, this->get_m()), i);
+    parallel_sort(positions.begin(), positions.end(),
+        [](const std::pair<unsigned long, unsigned long> &x, const std::pair<unsigned long, unsigned long> &y) {
+            return x.first < y.first;
+        }, num_threads);
+    auto block_of = [this](unsigned long position) {
+        return std::upper_bound(this->block_offsets->begin(), this->block_offsets->end(), position)
+            - this->block_offsets->begin() - 1;
+    };
+    std::vector<unsigned long> group_begins;
+    for(unsigned long i = 0ul; i < count; ++i) {
+        if (i == 0ul || block_of(positions[i - 1].first) != block_of(positions[i].first))
+            group_begins.push_back(i);
+    }
+    group_begins.push_back(count);
+    parallel_for(0ul, group_begins.size() - 1, [&](unsigned long g) {
+        unsigned long first = group_begins[g], last = group_begins[g + 1];
+        unsigned long b = block_of(positions[first].first);
+        std::vector<std::pair<unsigned long, unsigned long>> edges;
+        this->generate_block(b, &edges);
+        for(unsigned long i = first; i < last; ++i)
+            (*samples)[positions[i].second] = edges[positions[i].first - (*this->block_offsets)[b]];
+    }, num_threads);
+    return samples;
+}
+
+/**
+ * @brief writes x in decimal at p
+ *
+ * @param p the output buffer, with room for 20 digits
+ * @param x the number
+ * @return char* one past the last digit
+ */
+static inline char* append_number(char *p, unsigned long x) {
+    char digits[20];
+    unsigned int len = 0u;
+    do {
+        digits[len++] = static_cast<char>('0' + x % 10ul);
+        x /= 10ul;
+    } while (x > 0ul);
+    while (len > 0u)
+        *p++ = digits[--len];
+    return p;
+}
+
+void write_synthetic_edge_list(const SyntheticGraph *graph, std::string output, unsigned int num_threads) {
+    std::ofstream out(output, std::ios::out | std::ios::binary);
+    if (!out.is_open())
+        throw std::invalid_argument("File error: " + output);
+    out << graph->get_n() << " " << graph->get_m() << "\n";
+    unsigned long batch = resolve_num_threads(num_threads) * SYNTHETIC_BLOCKS_PER_THREAD;
+    std::vector<std::string> texts(batch);
+    for(unsigned long first = 0ul; first < graph->get_num_blocks(); first += batch) {
+        unsigned long last = std::min(graph->get_num_blocks(), first + batch);
+        parallel_for(first, last, [&](unsigned long b) {
+            std::vector<std::pair<unsigned long, unsigned long>> edges;
+            graph->generate_block(b, &edges);
+            auto &text = texts[b - first];
+            text.resize(edges.size() * 42ul);  //< two numbers of at most 20 digits, a space and a newline
+            char *p = &text[0];
+            for(auto &e: edges) {
+                p = append_number(p, e.first);
+                *p++ = ' ';
+                p = append_number(p, e.second);
+                *p++ = '\n';
+            }
+            text.resize(p - text.data());
+        }, num_threads);
+        for(unsigned long b = first; b < last; ++b)
+            out.write(texts[b - first].data(), texts[b - first].size());
+    }
+    if (!out)
+        throw std::invalid_argument("File error: " + output);
+}
+
+Graph* build_synthetic_graph(const SyntheticGraph *graph, unsigned int num_threads) {
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    edges.reserve(graph->get_m());
+    graph->for_each_block([&edges](unsigned long, const std::vector<std::pair<unsigned long, unsigned long>> &block) {
+        edges.insert(edges.end(), block.begin(), block.end());
+    }, num_threads);
+    auto g = new Graph();
+    g->load_from_edges(graph->get_n(), &edges, num_threads);
+    return g;
+}
+
+std::vector<Update>* synthetic_update_stream(const SyntheticGraph *graph, unsigned long num_updates,
+    unsigned long query_every, double eps, unsigned int num_threads)
+{
+    unsigned long state = block_state(graph->get_params().seed, ~0ul);
+    unsigned long num_removes = num_updates / 2, num_adds = num_updates - num_removes;
+    auto removed = graph->sample_edges(num_removes, next_random(state), num_threads);
+    // the added edges are edges of another graph of the same model
+    SyntheticGraphParams other_params = graph->get_params();
+    other_params.seed = next_random(state);
+    SyntheticGraph other(other_params, num_threads);
+    auto added = other.sample_edges(num_adds, next_random(state), num_threads);
+    auto updates = new std::vector<Update>();
+    unsigned long next_add = 0ul, next_remove = 0ul;
+    for(unsigned long i = 0ul; i < num_updates; ++i) {
+        unsigned long adds_left = num_adds - next_add, removes_left = num_removes - next_remove;
+        if (next_below(state, adds_left + removes_left) < adds_left) {
+            auto &e = (*added)[next_add++];
+            updates->push_back(Update{ADD_EDGE, e.first, e.second, 0.0});
+        }
+        else {
+            auto &e = (*removed)[next_remove++];
+            updates->push_back(Update{REMOVE_EDGE, e.first, e.second, 0.0});
+        }
+        if (query_every > 0ul && (i + 1) % query_every == 0ul)
+            updates->push_back(Update{QUERY, 0ul, 0ul, eps});
+    }
+    delete added;
+    delete removed;
+    return updates;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file SyntheticGraph.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Seeded parallel generators of large synthetic graphs and update streams
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef SYNTHETIC_GRAPH_H_
+#define SYNTHETIC_GRAPH_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "Graph.h"
+#include "Parallel.h"
+#include "UpdateLog.h"
+
+const unsigned long SYNTHETIC_BLOCK_EDGES = 1ul << 16;
+///< @note the expected number of edges of a block, the unit of parallel work
+const unsigned long SYNTHETIC_BLOCKS_PER_THREAD = 4ul;
+///< @note the blocks generated per thread before they are handed over in order
+
+/**
+ * @brief the random graph model of a SyntheticGraph
+ *
+ */
+enum SyntheticModel {
+    PLANTED_PARTITION,  ///< clusters of consecutive ids, positive edges with p_in inside and p_out across
+    RMAT,               ///< m recursive-matrix samples with quadrant probabilities a, b, c and 1 - a - b - c
+    ERDOS_RENYI         ///< every pair is a positive edge with probability p_in
+};
+
+/**
+ * @brief the parameters of a SyntheticGraph; the ones a model does not use are ignored
+ *
+ */
+struct SyntheticGraphParams {
+    SyntheticModel model = ERDOS_RENYI;
+    ///< the random graph model
+    unsigned long n = 0ul;
+    ///< the number of vertices
+    unsigned long clusters = 1ul;
+    ///< the number of planted clusters
+    double p_in = 0.0;
+    ///< the probability of a positive edge inside a cluster, 1 - p_in is the intra-cluster noise
+    double p_out = 0.0;
+    ///< the probability of a positive edge across two clusters, i.e., the inter-cluster noise
+    unsigned long m = 0ul;
+    ///< the number of R-MAT samples
+    double a = 0.57;
+    ///< the R-MAT probability of the top-left quadrant
+    double b = 0.19;
+    ///< the R-MAT probability of the top-right quadrant
+    double c = 0.19;
+    ///< the R-MAT probability of the bottom-left quadrant
+    unsigned long seed = 1ul;
+    ///< the seed, the only source of randomness
+};
+
+/**
+ * @brief A synthetic graph which is never stored, but generated in blocks
+ * on demand, in parallel, for streaming billions of edges.
+ * @details The edges are split into blocks of about SYNTHETIC_BLOCK_EDGES
+ * edges, each drawn from its own random stream seeded by the seed and the
+ * index of the block, so the edges are the same for any number of threads
+ * and any block can be generated again alone. For the planted partition and
+ * the Erdos-Renyi models a block is a range of rows u, and the neighbors
+ * v > u of each row are found by geometric skipping, in time linear in the
+ * edges; the constructor runs the skipping once only to count the edges of
+ * every block, so the total is known before the first edge is written. An
+ * R-MAT block is a range of the m samples; its samples may repeat an edge,
+ * which the loaders ignore.
+ */
+class SyntheticGraph {
+    protected:
+        SyntheticGraphParams params;
+        ///< the model and its parameters
+        unsigned long rows_per_block;
+        ///< the rows of a planted-partition or Erdos-Renyi block
+        std::vector<unsigned long> *block_offsets;
+        ///< the index of the first edge of every block, followed by m
+        /**
+         * @brief the first vertex of cluster c, for c = clusters it is n
+         *
+         * @param c cluster index starting at 0
+         * @return unsigned long
+         */
+        unsigned long cluster_begin(unsigned long c) const;
+        /**
+         * @brief draws the edges of block b, calling fn(u, v) for each in order
+         *
+         * @param b block index
+         * @param fn called as fn(u, v) with u < v
+         */
+        template<typename F>
+        void draw_block(unsigned long b, F fn) const;
+    public:
+        /**
+         * @brief Construct a new Synthetic Graph object and count the edges of its blocks
+         * @throws std::invalid_argument if the parameters do not describe a graph of the model
+         *
+         * @param params the model and its parameters
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        SyntheticGraph(const SyntheticGraphParams &params, unsigned int num_threads = 0u);
+        /**
+         * @brief Destroy the Synthetic Graph object
+         *
+         */
+        ~SyntheticGraph();
+        SyntheticGraph(const SyntheticGraph &) = delete;
+        SyntheticGraph &operator=(const SyntheticGraph &) = delete;
+        /**
+         * @brief the parameters of the graph
+         *
+         * @return const SyntheticGraphParams&
+         */
+        const SyntheticGraphParams &get_params() const { return this->params; };
+        /**
+         * @brief the number of vertices
+         *
+         * @return unsigned long
+         */
+        unsigned long get_n() const { return this->params.n; };
+        /**
+         * @brief the number of generated edges, counting R-MAT repetitions
+         *
+         * @return unsigned long
+         */
+        unsigned long get_m() const { return this->block_offsets->back(); };
+        /**
+         * @brief the number of blocks
+         *
+         * @return unsigned long
+         */
+        unsigned long get_num_blocks() const { return this->block_offsets->size() - 1; };
+        /**
+         * @brief appends the edges of block b to edges
+         *
+         * @param b block index, less than get_num_blocks()
+         * @param edges the output, the pairs {u,v} with u < v
+         */
+        void generate_block(unsigned long b, std::vector<std::pair<unsigned long, unsigned long>> *edges) const;
+        /**
+         * @brief the planted cluster of v, starting at 1 as the clusterings of
+         * the engines; it is 1 for every vertex of the other models
+         *
+         * @param v vertex id
+         * @return unsigned long
+         */
+        unsigned long cluster_of(unsigned long v) const;
+        /**
+         * @brief the edges at count positions of the edge stream drawn
+         * uniformly and independently, in the order they were drawn; only the
+         * blocks of the drawn positions are generated
+         *
+         * @param count number of edges
+         * @param seed the seed of the positions
+         * @param num_threads number of threads, 0 means all hardware threads
+         * @return std::vector<std::pair<unsigned long, unsigned long>>*
+         */
+        std::vector<std::pair<unsigned long, unsigned long>>* sample_edges(unsigned long count,
+            unsigned long seed, unsigned int num_threads = 0u) const;
+        /**
+         * @brief generates all the blocks, SYNTHETIC_BLOCKS_PER_THREAD per thread
+         * at a time in parallel, and calls fn(b, edges) for each block b in
+         * increasing order from the calling thread
+         *
+         * @param fn called as fn(b, edges) with the edges of block b
+         * @param num_threads number of threads, 0 means all hardware threads
+         */
+        template<typename F>
+        void for_each_block(F fn, unsigned int num_threads = 0u) const {
+            unsigned long batch = resolve_num_threads(num_threads) * SYNTHETIC_BLOCKS_PER_THREAD;
+            std::vector<std::vector<std::pair<unsigned long, unsigned long>>> buffers(batch);
+            for(unsigned long first = 0ul; first < this->get_num_blocks(); first += batch) {
+                unsigned long last = std::min(this->get_num_blocks(), first + batch);
+                parallel_for(first, last, [&](unsigned long b) {
+                    buffers[b - first].clear();
+                    this->generate_block(b, &buffers[b - first]);
+                }, num_threads);
+                for(unsigned long b = first; b < last; ++b)
+                    fn(b, buffers[b - first]);
+            }
+        };
+};
+
+/**
+ * @brief writes the graph as a text edge list, see Graph::load_from_file;
+ * the blocks are formatted in parallel and written in order, so the memory
+ * does not grow with the graph
+ * @throws std::invalid_argument if the file cannot be created
+ *
+ * @param graph the synthetic graph
+ * @param output exact address to the output file
+ * @param num_threads number of threads, 0 means all hardware threads
+ */
+void write_synthetic_edge_list(const SyntheticGraph *graph, std::string output, unsigned int num_threads = 0u);
+
+/**
+ * @brief loads all the edges of the synthetic graph in a new Graph, e.g. to
+ * save it as a binary graph file
+ *
+ * @param graph the synthetic graph
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return Graph*
+ */
+Graph* build_synthetic_graph(const SyntheticGraph *graph, unsigned int num_threads = 0u);
+
+/**
+ * @brief an update log for a dynamic benchmark on the synthetic graph:
+ * num_updates edge updates in random order, half of them removing sampled
+ * edges of the graph and the other half adding sampled edges of another
+ * graph of the same model, with a query after every query_every updates
+ * @details The added edges follow the distribution of the graph, e.g. the
+ * planted clusters; an added edge may already exist, and an edge may be
+ * removed twice, which the engines treat as no-ops.
+ *
+ * @param graph the synthetic graph
+ * @param num_updates number of edge updates
+ * @param query_every number of updates between two queries, 0 means no queries
+ * @param eps the eps of the queries
+ * @param num_threads number of threads, 0 means all hardware threads
+ * @return std::vector<Update>* the operations in order
+ */
+std::vector<Update>* synthetic_update_stream(const SyntheticGraph *graph, unsigned long num_updates,
+    unsigned long query_every, double eps, unsigned int num_threads = 0u);
+
+#endif // SYNTHETIC_GRAPH_H_
@@ -0,0 +1,83 @@
+#include "UnionFind.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include <utility>
+
+UnionFind::UnionFind(unsigned long n, unsigned int num_threads) {
+    check_vertex_id_bound(n);
+    this->parent = new std::vector<std::atomic<vertex_id_t>>(n);
+    parallel_for(0ul, n, [this](unsigned long v) {
+        (*this->parent)[v].store(v, std::memory_order_relaxed);
+    }, num_threads);
+}
+
+UnionFind::~UnionFind() {
+    delete this->parent;
+}
+
+unsigned long UnionFind::find(unsigned long v) {
+    auto &parent = *this->parent;
+    auto p = parent[v].load(std::memory_order_relaxed);
+    while (p != v) {
+        auto gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p) {
+            // path halving, which fails harmlessly if another thread moved v
+            parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        }
+        v = gp;
+        p = parent[v].load(std::memory_order_relaxed);
+    }
+    return v;
+}
+
+bool UnionFind::unite(unsigned long u, unsigned long v) {
+    auto &parent = *this->parent;
+    while (true) {
+        auto root_u = this->find(u);
+        auto root_v = this->find(v);
+        if (root_u == root_v)
+            return false;
+        if (root_u < root_v)
+            std::swap(root_u, root_v);
+        // linking the larger root, unless it stopped being a root meanwhile
+        vertex_id_t expected = root_u;
+        if (parent[root_u].compare_exchange_strong(expected, root_v, std::memory_order_relaxed)) {
+            stat_add(STAT_UNIONS);
+            return true;
+        }
+        u = root_u;
+        v = root_v;
+    }
+}
+
+std::vector<unsigned long>* UnionFind::labels(unsigned int num_threads) {
+    PhaseTimer timer(PHASE_LABELS);
+    auto n = this->parent->size();
+    auto assignment = new std::vector<unsigned long>(n, 0ul);
+    // a root is the smallest vertex of its set, so its label is the number of roots up to it
+    auto threads = std::max<unsigned long>(1ul, std::min<unsigned long>(resolve_num_threads(num_threads), n / 4096ul));
+    auto block = (n + threads - 1) / threads;
+    std::vector<unsigned long> roots_before(threads + 1, 0ul);
+    parallel_for(0ul, threads, [&](unsigned long t) {
+        unsigned long roots = 0ul;
+        for(unsigned long v = t * block; v < std::min(n, (t + 1) * block); ++v) {
+            if ((*this->parent)[v].load(std::memory_order_relaxed) == v)
+                (*assignment)[v] = ++roots;
+        }
+        roots_before[t + 1] = roots;
+    }, threads);
+    for(unsigned long t = 0ul; t < threads; ++t)
+        roots_before[t + 1] += roots_before[t];
+    parallel_for(0ul, threads, [&](unsigned long t) {
+        for(unsigned long v = t * block; v < std::min(n, (t + 1) * block); ++v) {
+            if ((*assignment)[v] != 0ul)
+                (*assignment)[v] += roots_before[t];
+        }
+    }, threads);
+    // the labels of the roots are final, the other vertices copy the label of their root
+    parallel_for(0ul, n, [&](unsigned long v) {
+        if ((*assignment)[v] == 0ul)
+            (*assignment)[v] = (*assignment)[this->find(v)];
+    }, threads);
+    return assignment;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file UnionFind.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Disjoint-set forest used to cluster the surviving positive edges
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef UNION_FIND_H_
+#define UNION_FIND_H_
+
+#include <vector>
+#include <atomic>
+#include "VertexId.h"
+
+/**
+ * @brief A lock-free disjoint-set forest over the vertices 0..n-1, so the
+ * connected components of a stream of edges are found in O(n) memory
+ * without materializing the graph of those edges, by any number of threads.
+ * @details A root is always the smallest vertex of its set: unite links the
+ * larger root under the smaller one with a compare-and-swap, and find halves
+ * the path with compare-and-swaps as well. Parents only decrease, so the
+ * forest never has a cycle, and concurrent unite and find calls are safe.
+ * As the roots are the smallest vertices, the labels are computed in
+ * parallel and do not depend on the order of the unions.
+ */
+class UnionFind {
+    protected:
+        std::vector<std::atomic<vertex_id_t>> *parent;
+        ///< parent of each vertex in the forest, a root is its own parent, parent[v] <= v
+    public:
+        /**
+         * @brief Construct n singleton sets
+         * @throws std::overflow_error if n ids do not fit in vertex_id_t
+         * 
+         * @param n the number of vertices
+         * @param num_threads number of threads to initialize them, 0 means all hardware threads
+         */
+        UnionFind(unsigned long n, unsigned int num_threads = 1u);
+        /**
+         * @brief Destroy the Union Find object
+         * 
+         */
+        ~UnionFind();
+        /**
+         * @brief returns the representative of the set containing v, safe to
+         * call concurrently with find and unite
+         * 
+         * @param v vertex id
+         * @return unsigned long the root of the tree of v, the smallest vertex of its set
+         */
+        unsigned long find(unsigned long v);
+        /**
+         * @brief merges the sets containing u and v, safe to call concurrently
+         * with find and unite
+         * 
+         * @param u vertex id
+         * @param v vertex id
+         * @return true if they were in different sets
+         * @return false otherwise
+         */
+        bool unite(unsigned long u, unsigned long v);
+        /**
+         * @brief returns the cluster assignment of the vertices, the clusters
+         * are numbered from 1 in increasing order of their smallest vertex
+         * @note no unite may run concurrently
+         * 
+         * @param num_threads number of threads, 0 means all hardware threads
+         * @return std::vector<unsigned long>* cluster assignment function starting at 1
+         */
+        std::vector<unsigned long>* labels(unsigned int num_threads = 1u);
+};
+
+#endif // UNION_FIND_H_
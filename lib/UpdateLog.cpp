@@ -0,0 +1,70 @@
+#include "UpdateLog.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+std::vector<Update>* read_update_log(std::string input) {
+    std::ifstream input_file(input, std::ios::in);
+    if (!input_file.is_open())
+        throw std::invalid_argument("File error: " + input);
+    auto updates = new std::vector<Update>();
+    std::string line;
+    unsigned long line_number = 0ul;
+    while (std::getline(input_file, line)) {
+        ++line_number;
+        std::istringstream tokens(line);
+        std::string command;
+        if (!(tokens >> command) || command[0] == '#')
+            continue;
+        Update update = {QUERY, 0ul, 0ul, 0.0};
+        bool valid = true;
+        if (command == "add_edge") {
+            update.type = ADD_EDGE;
+            valid = static_cast<bool>(tokens >> update.u >> update.v);
+        }
+        else if (command == "remove_edge") {
+            update.type = REMOVE_EDGE;
+            valid = static_cast<bool>(tokens >> update.u >> update.v);
+        }
+        else if (command == "add_vertex")
+            update.type = ADD_VERTEX;
+        else if (command == "remove_vertex") {
+            update.type = REMOVE_VERTEX;
+            valid = static_cast<bool>(tokens >> update.u);
+        }
+        else if (command == "query") {
+            update.type = QUERY;
+            valid = static_cast<bool>(tokens >> update.eps);
+        }
+        else
+            valid = false;
+        std::string rest;
+        if (!valid || (tokens >> rest)) {
+            delete updates;
+            throw std::runtime_error("Malformed line " + std::to_string(line_number)
+                + " of the update log " + input + ": " + line);
+        }
+        updates->push_back(update);
+    }
+    return updates;
+}
+
+void write_update(std::ostream &out, const Update &update) {
+    switch (update.type) {
+        case ADD_EDGE:
+            out << "add_edge " << update.u << " " << update.v << "\n";
+            break;
+        case REMOVE_EDGE:
+            out << "remove_edge " << update.u << " " << update.v << "\n";
+            break;
+        case ADD_VERTEX:
+            out << "add_vertex\n";
+            break;
+        case REMOVE_VERTEX:
+            out << "remove_vertex " << update.u << "\n";
+            break;
+        case QUERY:
+            out << "query " << update.eps << "\n";
+            break;
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file UpdateLog.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Logs of edge/vertex updates interleaved with queries, for replaying dynamic workloads
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef UPDATE_LOG_H_
+#define UPDATE_LOG_H_
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/**
+ * @brief the kind of an operation of an update log
+ *
+ */
+enum UpdateType {
+    ADD_EDGE,       ///< `add_edge u v`, adds the positive edge {u,v}
+    REMOVE_EDGE,    ///< `remove_edge u v`, removes the positive edge {u,v}
+    ADD_VERTEX,     ///< `add_vertex`, adds an isolated vertex whose id is the next unused one
+    REMOVE_VERTEX,  ///< `remove_vertex v`, removes v and all its positive edges
+    QUERY           ///< `query eps`, asks for the clustering for eps
+};
+
+/**
+ * @brief one operation of an update log
+ *
+ */
+struct Update {
+    UpdateType type;
+    ///< the kind of the operation
+    unsigned long u;
+    ///< the first vertex, if any
+    unsigned long v;
+    ///< the second vertex, if any
+    double eps;
+    ///< the eps of a query
+};
+
+/**
+ * @brief reads an update log, one operation per line as documented in
+ * UpdateType; blank lines and lines starting with `#` are skipped
+ * @throws std::invalid_argument if the file cannot be opened
+ * @throws std::runtime_error on a malformed line, the message has the line number
+ *
+ * @param input exact address to the update log
+ * @return std::vector<Update>* the operations in order
+ */
+std::vector<Update>* read_update_log(std::string input);
+
+/**
+ * @brief writes one operation as a line of an update log
+ *
+ * @param out the output stream
+ * @param update the operation
+ */
+void write_update(std::ostream &out, const Update &update);
+
+/**
+ * @brief true iff the operation modifies the graph, i.e., it is not a query
+ *
+ * @param update the operation
+ * @return bool
+ */
+inline bool is_graph_update(const Update &update) { return update.type != QUERY; }
+
+#endif // UPDATE_LOG_H_
@@ -0,0 +1,9 @@
+#include "VertexId.h"
+#include <stdexcept>
+#include <string>
+
+void check_vertex_id_bound(unsigned long n) {
+    if (n > VERTEX_ID_BOUND)
+        throw std::overflow_error(std::to_string(n) + " vertex ids do not fit in "
+            + std::to_string(8 * sizeof(vertex_id_t)) + "-bit ids, build without -DVERTEX_32BIT_IDS.");
+}
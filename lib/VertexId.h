@@ -0,0 +1,37 @@
+/**
+ * @file VertexId.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief The width of the vertex ids stored by the graphs, the NAOs and the clustering engines
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef VERTEX_ID_H_
+#define VERTEX_ID_H_
+
+#include <cstdint>
+#include <limits>
+
+#ifdef VERTEX_32BIT_IDS
+typedef std::uint32_t vertex_id_t;
+///< @note the type of the vertex ids in the adjacency lists, the CSR snapshots, the NAOs and
+///< the per-query arrays, 32-bit with -DVERTEX_32BIT_IDS, which halves their memory
+#else
+typedef unsigned long vertex_id_t;
+///< @note the type of the vertex ids in the adjacency lists, the CSR snapshots, the NAOs and
+///< the per-query arrays, 64-bit unless -DVERTEX_32BIT_IDS
+#endif
+
+const unsigned long VERTEX_ID_BOUND = std::numeric_limits<vertex_id_t>::max();
+///< @note every stored vertex id is below this, so the number of vertex ids is at most this
+
+/**
+ * @brief throws if n vertex ids do not fit in vertex_id_t
+ * @throws std::overflow_error if n > VERTEX_ID_BOUND
+ *
+ * @param n the number of vertex ids
+ */
+void check_vertex_id_bound(unsigned long n);
+
+#endif // VERTEX_ID_H_
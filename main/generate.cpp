@@ -0,0 +1,117 @@
+/**
+ * @file generate.cpp
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Writes seeded synthetic graphs, and optionally update logs, for the experiments
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include "lib/Graph.h"
+#include "lib/GraphCSR.h"
+#include "lib/SyntheticGraph.h"
+#include "lib/UpdateLog.h"
+
+const int NUM_ARGS = 2;
+
+/**
+ * @brief prints the usage and exits
+ *
+ */
+void print_usage() {
+    std::cerr << "./generate [planted|rmat|er] [output_filename] [key=value]..." << std::endl;
+    std::cerr << "keys:" << std::endl;
+    std::cerr << "  n=<vertices> seed=<seed> threads=<threads, 0 = all>" << std::endl;
+    std::cerr << "  clusters=<k> p_in=<probability> p_out=<probability>   (planted, er uses p_in)" << std::endl;
+    std::cerr << "  m=<samples> a=<0.57> b=<0.19> c=<0.19>                  (rmat)" << std::endl;
+    std::cerr << "  format=<text|binary>  a binary graph file keeps the whole graph in memory" << std::endl;
+    std::cerr << "  truth=<clustering_file>  the planted clusters, for the [cost] mode of hcc" << std::endl;
+    std::cerr << "  updates=<count> query_every=<count> eps=<eps> updates_file=<update_log_file>" << std::endl;
+    std::exit(1);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < NUM_ARGS + 1)
+        print_usage();
+    std::string model = argv[1];
+    std::string output_filename = argv[2];
+    std::map<std::string, std::string> options;
+    for(int i = NUM_ARGS + 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto eq = arg.find('=');
+        if (eq == std::string::npos)
+            print_usage();
+        options[arg.substr(0, eq)] = arg.substr(eq + 1);
+    }
+    auto option = [&options](std::string key, std::string fallback) {
+        auto it = options.find(key);
+        return (it == options.end()) ? fallback : it->second;
+    };
+    SyntheticGraphParams params;
+    if (model == "planted")
+        params.model = PLANTED_PARTITION;
+    else if (model == "rmat")
+        params.model = RMAT;
+    else if (model == "er")
+        params.model = ERDOS_RENYI;
+    else
+        print_usage();
+    unsigned int num_threads = 0u;
+    try {
+        params.n = std::stoul(option("n", "0"));
+        params.seed = std::stoul(option("seed", "1"));
+        params.clusters = std::stoul(option("clusters", "1"));
+        params.p_in = std::stod(option("p_in", "0"));
+        params.p_out = std::stod(option("p_out", "0"));
+        params.m = std::stoul(option("m", "0"));
+        params.a = std::stod(option("a", "0.57"));
+        params.b = std::stod(option("b", "0.19"));
+        params.c = std::stod(option("c", "0.19"));
+        num_threads = std::stoul(option("threads", "0"));
+    }
+    catch(const std::logic_error &e) {
+        std::cerr << "Malformed option: " << e.what() << std::endl;
+        print_usage();
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto graph = new SyntheticGraph(params, num_threads);
+    std::cout << "Generating " << graph->get_m() << " edges on " << graph->get_n() << " vertices in "
+        << graph->get_num_blocks() << " blocks" << std::endl;
+    if (option("format", "text") == "binary") {
+        auto g = build_synthetic_graph(graph, num_threads);
+        auto csr = new GraphCSR(g);
+        csr->save_to_binary_file(output_filename);
+        delete csr;
+        delete g;
+    }
+    else
+        write_synthetic_edge_list(graph, output_filename, num_threads);
+    auto t_write = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - t1
+    );
+    std::cout << "Time to generate the graph into " << output_filename << " = " << t_write.count() << " (ms)" << std::endl;
+    if (options.count("truth")) {
+        std::ofstream truth_file(options["truth"]);
+        for(unsigned long v = 0ul; v < graph->get_n(); ++v)
+            truth_file << v << "\t" << graph->cluster_of(v) << "\n";
+        std::cout << "The planted clusters are written into " << options["truth"] << std::endl;
+    }
+    if (options.count("updates")) {
+        auto updates = synthetic_update_stream(graph, std::stoul(options["updates"]),
+            std::stoul(option("query_every", "0")), std::stod(option("eps", "0.5")), num_threads);
+        auto updates_filename = option("updates_file", output_filename + ".updates");
+        std::ofstream updates_file(updates_filename);
+        for(auto &update: *updates)
+            write_update(updates_file, update);
+        std::cout << updates->size() << " operations are written into " << updates_filename << std::endl;
+        delete updates;
+    }
+    delete graph;
+    return EXIT_SUCCESS;
+}
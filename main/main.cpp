@@ -10,39 +10,94 @@
 #include <iostream>
 #include <chrono>
 #include <fstream>
+#include <cmath>
+#include <stdexcept>
 #include "lib/Graph.h"
+#include "lib/EdgeListParser.h"
+#include "lib/GraphCSR.h"
+#include "lib/Parallel.h"
 #include "lib/NAO.h"
+#include "lib/NAOArena.h"
 #include "lib/NaiveCorrelationClustering.h"
 #include "lib/IndexBasedCorrelationClustering.h"
+#include "lib/HierarchicalCorrelationClustering.h"
+#include "lib/UpdateLog.h"
+#include "lib/ClusteringCost.h"
+#include "lib/Stats.h"
+#include "lib/ClusteringSink.h"
 
 const unsigned int NUM_ARGS = 3;
 std::vector<double> eps_schedule;
 std::vector<std::pair<double, std::vector<unsigned long>*>>* hierarchical = nullptr;
+ClusteringSink *clustering_sink = nullptr;
+//< the format of the clustering files, set by --output=tsv|binary|varint
+bool hierarchy_change_log = false;
+//< whether a hierarchical run writes one change log per engine instead of a file per level, set by --hierarchy=changelog
 
 void write_clustering_to_file(std::string filename, std::vector<unsigned long>* output);
+void report_clustering_cost(GraphCSR *g, std::string name, std::vector<unsigned long>* output);
 void write_distribution_to_file(std::string filename, std::map<double, unsigned long>* output);
 unsigned short show_menu();
-void get_nao_construction_time(Graph *g);
-void get_correlation_clustering(Graph *g, double eps, std::string output_prefix);
-void get_index_based_correlation_clustering(Graph *g, double eps, std::string output_prefix);
-std::map<double, unsigned long>* get_all_eps(Graph *g, std::string output_prefix);
+void get_nao_construction_time(GraphCSR *g);
+void get_correlation_clustering(GraphCSR *g, double eps, std::string output_prefix);
+void get_index_based_correlation_clustering(GraphCSR *g, double eps, std::string output_prefix);
+std::map<double, unsigned long>* get_all_eps(GraphCSR *g, std::string output_prefix);
 void get_eps_schedule();
 void set_eps_schedule();
-void get_hierarchical_correlation_clustering(Graph *g, std::string output_prefix);
+void get_hierarchical_correlation_clustering(GraphCSR *g, std::string output_prefix);
+void save_graph_to_binary_file(GraphCSR *g, std::string output_filename);
+void replay_update_log(GraphCSR *g, std::string log_filename);
+void dump_stats(std::string output_prefix, std::string run);
 
 int main(int argc, char* argv[]) {
+    // the --output and --hierarchy options may appear anywhere and are removed from the positional arguments
+    std::string output_format = "tsv";
+    int num_positional = 0;
+    for(int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--output=", 0) == 0)
+            output_format = arg.substr(9);
+        else if (arg.rfind("--hierarchy=", 0) == 0) {
+            if (arg.substr(12) != "files" && arg.substr(12) != "changelog")
+                throw std::invalid_argument("Unknown hierarchy output " + arg.substr(12) + ", expected files or changelog.");
+            hierarchy_change_log = arg.substr(12) == "changelog";
+        }
+        else
+            argv[num_positional++] = argv[i];
+    }
+    argc = num_positional;
+    clustering_sink = make_clustering_sink(output_format);
     if (argc < NUM_ARGS + 1) {
         std::cerr << "./main [input_filename] [output_prefix] [default_eps] [batch] [eps-schedule-file]" << std::endl;
         std::cerr << "./main [input_filename] [output_prefix] [default_eps] [auto-batch] [eps-schedule-length]" << std::endl;
+        std::cerr << "./main [input_filename] [output_prefix] [default_eps] [to-binary] [binary-output-file]" << std::endl;
+        std::cerr << "./main [input_filename] [output_prefix] [default_eps] [replay] [update-log-file]" << std::endl;
+        std::cerr << "./main [input_filename] [output_prefix] [default_eps] [cost] [clustering-file]" << std::endl;
+        std::cerr << "input_filename is either a text edge list or a binary graph file" << std::endl;
+        std::cerr << "--output=tsv|binary|varint sets the format of the clustering files (default tsv)" << std::endl;
+        std::cerr << "--hierarchy=changelog writes the levels of a hierarchical run as one change log per engine (default files)" << std::endl;
         std::exit(1);
     }
-    // reading the graph in memory
+    // reading the graph as a static snapshot; a binary graph file is
+    // mapped read-only and used in place, only the replay copies it into a dynamic Graph
     std::string input_filename = argv[1];
     std::string output_prefix = argv[2];
     auto default_eps = std::stod(argv[3]);
-    Graph *g = new Graph();
+    GraphCSR *g = nullptr;
     auto t1 = std::chrono::high_resolution_clock::now();
-    g->load_from_file(input_filename);
+    if (GraphCSR::is_binary_file(input_filename)) {
+        PhaseTimer timer(PHASE_LOAD);
+        g = new GraphCSR(input_filename, true);
+    }
+    else {
+        PhaseTimer timer(PHASE_LOAD);
+        auto parser = new EdgeListParser(input_filename);
+        std::cout << "Parsed " << parser->get_bytes() / 1e6 << " MB of text with "
+            << parser->get_num_threads() << " thread(s) at " << parser->get_throughput()
+            << " MB/s" << std::endl;
+        g = new GraphCSR(parser->get_n(), parser->get_edges());
+        delete parser;
+    }
     auto t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::high_resolution_clock::now() - t1
     );
@@ -52,10 +107,47 @@ int main(int argc, char* argv[]) {
             << ", m: " << m
             << " is: " << t_read.count() << " ms"
             << std::endl;
+    auto run_prefix = input_filename + "_" + output_prefix;
+    //< the prefix of all the output files
+    dump_stats(run_prefix, "load");
     auto get_all_eps_vect = new std::map<double, unsigned long>();
     unsigned long eps_schedule_len = 0ul;
     if (argc == NUM_ARGS + 1 + 2) {
-        auto batch_mode = argv[4];
+        auto batch_mode = std::string(argv[4]);
+        if (batch_mode == "to-binary") {
+            save_graph_to_binary_file(g, argv[5]);
+            dump_stats(run_prefix, "to-binary");
+            return EXIT_SUCCESS;
+        }
+        if (batch_mode == "replay") {
+            replay_update_log(g, argv[5]);
+            dump_stats(run_prefix, "replay");
+            return EXIT_SUCCESS;
+        }
+        if (batch_mode == "cost" && ClusteringChangeLog::is_change_log_file(argv[5])) {
+            // every level of a hierarchical run
+            auto change_log = new ClusteringChangeLog(argv[5]);
+            auto clusterings = change_log->clusterings();
+            for(unsigned long i = 0ul; i < clusterings->size(); ++i) {
+                (*clusterings)[i]->resize(g->get_n(), SINGLETON_CLUSTER);
+                report_clustering_cost(g, std::string(argv[5]) + " (eps = " + std::to_string(change_log->get_eps(i)) + ")",
+                    (*clusterings)[i]);
+                delete (*clusterings)[i];
+            }
+            delete clusterings;
+            delete change_log;
+            dump_stats(run_prefix, "cost");
+            return EXIT_SUCCESS;
+        }
+        if (batch_mode == "cost") {
+            auto clustering = read_clustering(argv[5]);
+            clustering->resize(g->get_n(), SINGLETON_CLUSTER);
+            //< the vertices missing from the file are alone in their clusters
+            report_clustering_cost(g, argv[5], clustering);
+            delete clustering;
+            dump_stats(run_prefix, "cost");
+            return EXIT_SUCCESS;
+        }
         if (batch_mode == "batch") {
             auto eps_schedule_file = argv[5];
             std::ifstream eps_file_handler(eps_schedule_file, std::ios::in);
@@ -71,9 +163,13 @@ int main(int argc, char* argv[]) {
             eps_schedule_len = std::stoul(argv[5]);
         }
         get_nao_construction_time(g);
+        dump_stats(run_prefix, "nao");
         get_correlation_clustering(g, default_eps, input_filename + "_" + output_prefix);
+        dump_stats(run_prefix, "naive");
         get_index_based_correlation_clustering(g, default_eps, input_filename + "_" + output_prefix);
+        dump_stats(run_prefix, "index");
         get_all_eps_vect = get_all_eps(g, input_filename + "_" + output_prefix);
+        dump_stats(run_prefix, "all-eps");
         if (eps_schedule_len != 0ul) {
             // we get `eps_schedule_len` of the eps values from
             // get_all_eps_vect
@@ -96,6 +192,7 @@ int main(int argc, char* argv[]) {
         }
         get_eps_schedule();
         get_hierarchical_correlation_clustering(g, input_filename + "_" + output_prefix);
+        dump_stats(run_prefix, "hierarchical");
     }
     else {
         while (true) {
@@ -106,15 +203,19 @@ int main(int argc, char* argv[]) {
                     break;
                 case 1:
                     get_nao_construction_time(g);
+                    dump_stats(run_prefix, "nao");
                     break;
                 case 2: 
                     get_correlation_clustering(g, default_eps, input_filename + "_" + output_prefix);
+                    dump_stats(run_prefix, "naive");
                     break;
                 case 3: 
                     get_index_based_correlation_clustering(g, default_eps, input_filename + "_" + output_prefix);
+                    dump_stats(run_prefix, "index");
                     break;
                 case 4: 
                     get_all_eps_vect = get_all_eps(g, input_filename + "_" + output_prefix);
+                    dump_stats(run_prefix, "all-eps");
                     break;
                 case 5: 
                     get_eps_schedule();
@@ -123,8 +224,10 @@ int main(int argc, char* argv[]) {
                     set_eps_schedule();
                     break; 
                 case 7:
-                    if (eps_schedule.size() > 0)
+                    if (eps_schedule.size() > 0) {
                         get_hierarchical_correlation_clustering(g, input_filename + "_" + output_prefix);
+                        dump_stats(run_prefix, "hierarchical");
+                    }
                     else
                         std::cerr << "No epsilon schedule is defined." << std::endl;
                     break; 
@@ -138,6 +241,10 @@ int main(int argc, char* argv[]) {
                     std::cout << "Give me the default epsilon value: ";
                     std::cin >> default_eps;
                     break; 
+                case 11:
+                    save_graph_to_binary_file(g, input_filename + ".csr");
+                    dump_stats(run_prefix, "to-binary");
+                    break; 
                 default:
                     std::cerr << "Invalid choice.";
             }
@@ -147,13 +254,21 @@ int main(int argc, char* argv[]) {
 }
 
 void write_clustering_to_file(std::string filename, std::vector<unsigned long>* output) {
-    auto out_file = new std::ofstream(filename);
-    for(unsigned long i = 0ul; i < output->size(); ++i) {
-        (*out_file) << i << "\t" << output->at(i) << std::endl;
-    }
-    out_file->close();
-    delete out_file;
-    out_file = nullptr;
+    // the extension of the format completes the file name
+    clustering_sink->write(filename + clustering_sink->extension(), output);
+}
+
+void report_clustering_cost(GraphCSR *g, std::string name, std::vector<unsigned long>* output) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto cost = clustering_cost(g, output);
+    auto t_cost = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - t1
+    );
+    std::cout << "Cost of the " << name << ": " << cost.total()
+        << " (" << cost.positive_across << " positive edges across, "
+        << cost.negative_within << " negative pairs within "
+        << cost.clusters << " clusters), computed in " << t_cost.count() / 1000.0 << " ms"
+        << std::endl;
 }
 
 unsigned short show_menu() {
@@ -169,36 +284,43 @@ unsigned short show_menu() {
         << "8. Get Flat Clustering" << "\n"
         << "9. Get default eps" << "\n"
         << "10. Set default eps" << "\n"
+        << "11. Save the graph in binary format" << "\n"
         << std::endl;
     unsigned short choice = -1;
     std::cin >> choice;
     return choice;
 }
 
-void get_nao_construction_time(Graph *g) {
-    // constructing the NAOs for the current graph
+void get_nao_construction_time(GraphCSR *csr) {
+    // constructing the NAOs for the current graph with an increasing
+    // number of threads to report the scaling
     // note: it is just for timing purpose, as the 
     // naos would be created inside their corresponding
     // correlation clustering classes
-    auto t1 = std::chrono::high_resolution_clock::now();
-    NAO ** naos = nullptr;
-    auto n = g->get_n();
-    naos = new NAO*[n];
-    for(unsigned long i = 0ul; i < n; ++i) {
-        naos[i] = new NAO(i, g);
-    }
-    auto t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::high_resolution_clock::now() - t1
-    );
-    std::cout << "Time to construct NAOs: " << t_read.count() << " ms"
-            << std::endl;
-    for(unsigned long i = 0ul; i < n; ++i) {
-        delete naos[i];
+    auto max_threads = resolve_num_threads(0u);
+    std::vector<unsigned int> thread_counts;
+    for(unsigned int t = 1u; t < max_threads; t *= 2u)
+        thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+    double single_thread_time = 0.0;
+    for(auto num_threads: thread_counts) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        auto naos = new NAOArena(csr, num_threads);
+        auto t_read = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - t1
+        );
+        if (num_threads == 1u)
+            single_thread_time = t_read.count();
+        std::cout << "Time to construct NAOs with " << num_threads << " thread(s): " 
+                << t_read.count() / 1000 << " ms (speedup: " 
+                << single_thread_time / std::max<long>(t_read.count(), 1l) << "x, "
+                << naos->memory_bytes() / (1024 * 1024) << " MB)"
+                << std::endl;
+        delete naos;
     }
-    delete [] naos;
 }
 
-void get_correlation_clustering(Graph *g, double eps, std::string output_prefix) {
+void get_correlation_clustering(GraphCSR *g, double eps, std::string output_prefix) {
     // doing the naive correlation clustering, without NAOs
     auto t1 = std::chrono::high_resolution_clock::now();
     auto naive_corr_clust = new NaiveCorrelationClustering(g);
@@ -206,13 +328,15 @@ void get_correlation_clustering(Graph *g, double eps, std::string output_prefix)
     auto t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::high_resolution_clock::now() - t1
     );
-    write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_naive.out", output);
+    write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_naive", output);
     std::cout << "Time for naive correlation clustering: " << t_read.count() << " ms"
             << std::endl;
+    report_clustering_cost(g, "naive clustering", output);
+    delete output;
     delete naive_corr_clust;
 }
 
-void get_index_based_correlation_clustering(Graph *g, double eps, std::string output_prefix) {
+void get_index_based_correlation_clustering(GraphCSR *g, double eps, std::string output_prefix) {
     // doing the index-based correlation clustering with NAOs
     auto t1 = std::chrono::high_resolution_clock::now();
     auto index_corr_clust = new IndexBasedCorrelationClustering(g);
@@ -220,13 +344,15 @@ void get_index_based_correlation_clustering(Graph *g, double eps, std::string ou
     auto t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::high_resolution_clock::now() - t1
     );
-    write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_index.out", output);
+    write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_index", output);
     std::cout << "Time for index-based correlation clustering: " << t_read.count() << " ms"
             << std::endl;
+    report_clustering_cost(g, "index-based clustering", output);
+    delete output;
     delete index_corr_clust;
 }
 
-std::map<double, unsigned long>* get_all_eps(Graph *g, std::string output_prefix) {
+std::map<double, unsigned long>* get_all_eps(GraphCSR *g, std::string output_prefix) {
     auto index_corr_clust = new IndexBasedCorrelationClustering(g);
     auto output = index_corr_clust->get_all_eps();
     write_distribution_to_file(output_prefix + "_eps.out", output);
@@ -265,38 +391,227 @@ void set_eps_schedule() {
     std::sort(eps_schedule.begin(), eps_schedule.end());
 }
 
-void get_hierarchical_correlation_clustering(Graph *g, std::string output_prefix) {
+void get_hierarchical_correlation_clustering(GraphCSR *g, std::string output_prefix) {
     auto t1 = std::chrono::high_resolution_clock::now();
-    auto index_corr_clust = new IndexBasedCorrelationClustering(g);
+    auto hierarchical_corr_clust = new HierarchicalCorrelationClustering(g);
     auto t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::high_resolution_clock::now() - t1
     );
-    std::cout << "Time for constructing the index-based correlation clustering object: " 
+    std::cout << "Time for constructing the hierarchical correlation clustering object: " 
         << t_read.count() << " ms" << std::endl;
-    
+    ClusteringChangeLogWriter *naive_log = nullptr, *index_log = nullptr;
+    //< the change logs of --hierarchy=changelog, opened with the first level
     for(auto eps: eps_schedule) {    
         // first, naive correlation clustering
         t1 = std::chrono::high_resolution_clock::now();
         auto naive_corr_clust = new NaiveCorrelationClustering(g);
         auto output_naive = naive_corr_clust->query(eps);
-        write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_naive.out", output_naive);
+        if (hierarchy_change_log) {
+            if (naive_log == nullptr)
+                naive_log = new ClusteringChangeLogWriter(output_prefix + "_naive.hcl", output_naive->size());
+            naive_log->add_level(eps, output_naive);
+        }
+        else
+            write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_naive", output_naive);
         t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::high_resolution_clock::now() - t1
         );
         std::cout << "Time for querying naive correlation clustering (eps = " << eps << ") is: "
             << t_read.count() << " ms" << std::endl;
-        index_corr_clust->reset_naos();
-        // now use the index
-        t1 = std::chrono::high_resolution_clock::now();
-        auto output = index_corr_clust->query(eps);
-        write_clustering_to_file(output_prefix + "_" + std::to_string(eps) + "_index.out", output);
-        t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::high_resolution_clock::now() - t1
-        );
-        std::cout << "Time for querying correlation clustering (eps = " << eps << ") is: "
-            << t_read.count() << " ms" << std::endl;
-        index_corr_clust->reset_naos();
+        report_clustering_cost(g, "naive clustering (eps = " + std::to_string(eps) + ")", output_naive);
+        delete output_naive;
+        delete naive_corr_clust;
+    }
+    // now all the levels in one sweep
+    t1 = std::chrono::high_resolution_clock::now();
+    auto outputs = hierarchical_corr_clust->query(eps_schedule);
+    t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - t1
+    );
+    std::cout << "Time for querying correlation clustering for all " << eps_schedule.size()
+        << " eps values in one sweep is: " << t_read.count() << " ms ("
+        << hierarchical_corr_clust->get_rebuilds() << " levels rebuilt)" << std::endl;
+    for(unsigned long i = 0ul; i < outputs->size(); ++i) {
+        if (hierarchy_change_log) {
+            if (index_log == nullptr)
+                index_log = new ClusteringChangeLogWriter(output_prefix + "_index.hcl", (*outputs)[i]->size());
+            index_log->add_level(eps_schedule[i], (*outputs)[i]);
+        }
+        else
+            write_clustering_to_file(output_prefix + "_" + std::to_string(eps_schedule[i]) + "_index", (*outputs)[i]);
+        report_clustering_cost(g, "hierarchical clustering (eps = " + std::to_string(eps_schedule[i]) + ")", (*outputs)[i]);
+        delete (*outputs)[i];
     }
+    for(auto log: {std::make_pair("naive", naive_log), std::make_pair("index", index_log)}) {
+        if (log.second == nullptr)
+            continue;
+        log.second->close();
+        std::cout << "Wrote " << log.second->get_num_levels() << " levels of the " << log.first << " clustering as "
+            << log.second->get_num_changes() << " changes into " << output_prefix << "_" << log.first << ".hcl" << std::endl;
+        delete log.second;
+    }
+
+    delete outputs;
+    delete hierarchical_corr_clust;
+}
+
+void save_graph_to_binary_file(GraphCSR *g, std::string output_filename) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    g->save_to_binary_file(output_filename);
+    auto t_read = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - t1
+    );
+    std::cout << "Time to save the graph in binary format to " << output_filename
+        << " is: " << t_read.count() << " ms" << std::endl;
+}
+
+/**
+ * @brief the measurements of replaying an update log on one engine
+ *
+ */
+struct ReplayReport {
+    std::vector<double> update_latencies;
+    ///< the latency of each applied update in microseconds
+    std::vector<double> query_latencies;
+    ///< the latency of each query in microseconds
+    std::vector<unsigned long> query_hashes;
+    ///< a hash of the output of each query, to compare the engines
+    unsigned long rejected = 0ul;
+    ///< the number of updates on removed or unknown vertices
+    double total_seconds = 0.0;
+    ///< the wall-clock time of the whole replay
+};
 
+/**
+ * @brief returns the q-quantile of the samples (nearest rank), sorting them
+ *
+ */
+double get_percentile(std::vector<double> &samples, double q) {
+    if (samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    auto rank = static_cast<unsigned long>(std::ceil(q * samples.size()));
+    return samples[std::min<unsigned long>(std::max<unsigned long>(rank, 1ul), samples.size()) - 1];
+}
+
+/**
+ * @brief replays the operations on an engine given by two callbacks,
+ * apply(update) which may throw for an invalid update and query(eps)
+ *
+ */
+template<typename Apply, typename Query>
+ReplayReport replay_operations(const std::vector<Update> *updates, Apply apply, Query query) {
+    ReplayReport report;
+    auto t_start = std::chrono::high_resolution_clock::now();
+    for(auto &update: *updates) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        if (update.type == QUERY) {
+            auto output = query(update.eps);
+            report.query_latencies.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::high_resolution_clock::now() - t1).count());
+            unsigned long hash = 14695981039346656037ul;
+            for(auto label: *output)
+                hash = (hash ^ label) * 1099511628211ul;
+            report.query_hashes.push_back(hash);
+            delete output;
+            continue;
+        }
+        try {
+            apply(update);
+        }
+        catch (std::logic_error &e) {
+            // removed vertices (std::logic_error) or unknown ids (std::out_of_range)
+            report.rejected++;
+            continue;
+        }
+        report.update_latencies.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::high_resolution_clock::now() - t1).count());
+    }
+    report.total_seconds = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - t_start).count();
+    return report;
+}
+
+void print_replay_report(std::string engine, ReplayReport &report) {
+    auto updates = report.update_latencies.size();
+    std::cout << engine << ": " << updates << " updates ("
+        << report.rejected << " rejected), " << report.query_latencies.size() << " queries in "
+        << report.total_seconds * 1000 << " ms, " << updates / std::max(report.total_seconds, 1e-9)
+        << " updates/s sustained" << std::endl;
+    std::cout << "\tupdate latency p50/p99/p999: "
+        << get_percentile(report.update_latencies, 0.5) << " / "
+        << get_percentile(report.update_latencies, 0.99) << " / "
+        << get_percentile(report.update_latencies, 0.999) << " us" << std::endl;
+    std::cout << "\tquery latency p50/p99/p999: "
+        << get_percentile(report.query_latencies, 0.5) << " / "
+        << get_percentile(report.query_latencies, 0.99) << " / "
+        << get_percentile(report.query_latencies, 0.999) << " us" << std::endl;
+}
+
+void replay_update_log(GraphCSR *csr, std::string log_filename) {
+    auto updates = read_update_log(log_filename);
+    // the updates need the dynamic graph, a copy of the snapshot
+    auto g = new Graph();
+    g->load_from_adjacency(csr->get_n(), csr->get_offsets(), csr->get_neighbors());
+    std::cout << "Replaying " << updates->size() << " operations from " << log_filename << std::endl;
+    // the index-based engine repairs its NAOs on every update
+    auto index_corr_clust = new IndexBasedCorrelationClustering(g);
+    auto index_report = replay_operations(updates,
+        [&](const Update &update) {
+            switch (update.type) {
+                case ADD_EDGE: index_corr_clust->add_edge(update.u, update.v); break;
+                case REMOVE_EDGE: index_corr_clust->remove_edge(update.u, update.v); break;
+                case ADD_VERTEX: index_corr_clust->add_vertex(); break;
+                case REMOVE_VERTEX: index_corr_clust->remove_vertex(update.u); break;
+                default: break;
+            }
+        },
+        [&](double eps) { return index_corr_clust->query(eps); }
+    );
     delete index_corr_clust;
+    print_replay_report("index-based", index_report);
+    // the baseline only updates the graph and rebuilds the index on every query
+    auto rebuilt_g = new Graph(g);
+    auto rebuild_report = replay_operations(updates,
+        [&](const Update &update) {
+            switch (update.type) {
+                case ADD_EDGE:
+                case REMOVE_EDGE:
+                    rebuilt_g->deg_positive(update.u); // throws if u is removed
+                    rebuilt_g->deg_positive(update.v); // throws if v is removed
+                    if (update.type == ADD_EDGE)
+                        rebuilt_g->add_positive_edge(update.u, update.v);
+                    else
+                        rebuilt_g->remove_positive_edge(update.u, update.v);
+                    break;
+                case ADD_VERTEX: rebuilt_g->add_vertex(); break;
+                case REMOVE_VERTEX: rebuilt_g->remove_vertex(update.u); break;
+                default: break;
+            }
+        },
+        [&](double eps) {
+            auto rebuilt_corr_clust = new IndexBasedCorrelationClustering(rebuilt_g);
+            auto output = rebuilt_corr_clust->query(eps);
+            delete rebuilt_corr_clust;
+            return output;
+        }
+    );
+    delete rebuilt_g;
+    delete g;
+    print_replay_report("rebuild-from-scratch", rebuild_report);
+    unsigned long mismatches = 0ul;
+    for(unsigned long i = 0ul; i < index_report.query_hashes.size(); ++i)
+        mismatches += index_report.query_hashes[i] != rebuild_report.query_hashes[i];
+    std::cout << "The two engines " << ((mismatches == 0ul) ? "agree on all queries" :
+        "disagree on " + std::to_string(mismatches) + " queries") << std::endl;
+    delete updates;
+}
+
+void dump_stats(std::string output_prefix, std::string run) {
+    // the statistics since the last dump, so each run has its own file
+    auto filename = output_prefix + "_" + run + "_stats.json";
+    std::ofstream stats_file(filename);
+    write_stats_json(stats_file, run);
+    stats_reset();
+    std::cout << "The statistics of the " << run << " run are written into " << filename << std::endl;
 }
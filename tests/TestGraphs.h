@@ -0,0 +1,60 @@
+/**
+ * @file TestGraphs.h
+ * @author Ali Shakiba (a.shakiba.iran@gmail.com)
+ * @brief Small seeded graphs shared by the tests, so they need no data files
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright GNU GPLv3
+ */
+
+#ifndef TEST_GRAPHS_H_
+#define TEST_GRAPHS_H_
+
+#include <random>
+#include <utility>
+#include <vector>
+#include "../lib/Graph.h"
+
+/**
+ * @brief the edges of a planted partition of n vertices into clusters of
+ * consecutive ids, with a positive edge inside a cluster with probability
+ * p_in and across two clusters with probability p_out
+ * @details Small clusters and dense insides give many triangles and many
+ * edges with the same non-agreement, i.e., ties for the eps schedules.
+ *
+ * @param n number of vertices
+ * @param clusters number of clusters
+ * @param p_in the probability of an edge inside a cluster
+ * @param p_out the probability of an edge across two clusters
+ * @param seed the seed
+ * @return std::vector<std::pair<unsigned long, unsigned long>>
+ */
+inline std::vector<std::pair<unsigned long, unsigned long>> test_edges(unsigned long n,
+    unsigned long clusters = 12ul, double p_in = 0.6, double p_out = 0.02, unsigned long seed = 1ul)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    for(unsigned long u = 0ul; u < n; ++u) {
+        for(unsigned long v = u + 1; v < n; ++v) {
+            auto p = (u * clusters / n == v * clusters / n) ? p_in : p_out;
+            if (coin(rng) < p)
+                edges.push_back(std::make_pair(u, v));
+        }
+    }
+    return edges;
+}
+
+/**
+ * @brief loads g with test_edges(n), see test_edges for the parameters
+ *
+ * @param g the graph
+ * @param n number of vertices
+ * @param seed the seed
+ */
+inline void load_test_graph(Graph *g, unsigned long n = 240ul, unsigned long seed = 1ul) {
+    auto edges = test_edges(n, 12ul, 0.6, 0.02, seed);
+    g->load_from_edges(n, &edges);
+}
+
+#endif // TEST_GRAPHS_H_
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include "../lib/ClusteringCost.h"
+
+/**
+ * @brief the cost by checking every pair of vertices
+ */
+static unsigned long brute_force_cost(Graph *g, const std::vector<unsigned long> &assignment) {
+    unsigned long cost = 0ul;
+    for(unsigned long u = 0ul; u < assignment.size(); ++u) {
+        for(unsigned long v = u + 1; v < assignment.size(); ++v) {
+            bool positive = g->is_in_neigh_plus(u, v);
+            bool together = assignment[u] == assignment[v] && assignment[u] != SINGLETON_CLUSTER;
+            cost += (positive != together);
+        }
+    }
+    return cost;
+}
+
+TEST(ClusteringCost, MatchesBruteForce) {
+    const unsigned long N = 300ul;
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    unsigned long x = 7ul;
+    for(unsigned long i = 0ul; i < 2000ul; ++i) {
+        x = x * 6364136223846793005ul + 1442695040888963407ul;
+        auto u = (x >> 33) % N;
+        // mostly within blocks of 10 vertices, so the clusters matter
+        auto v = (i % 4 == 0) ? (x >> 20) % N : (u / 10) * 10 + (x >> 45) % 10;
+        if (u != v)
+            edges.push_back(std::make_pair(u, v));
+    }
+    Graph g;
+    g.load_from_edges(N, &edges);
+    GraphCSR csr(N, &edges);
+    std::vector<unsigned long> by_block(N), singletons(N), one(N, 1ul), large(N), partial(N);
+    for(unsigned long v = 0ul; v < N; ++v) {
+        by_block[v] = v / 10 + 1;
+        singletons[v] = v + 1;
+        large[v] = (v / 10 + 1) * 9000000000000ul;
+        partial[v] = (v % 7 == 0) ? SINGLETON_CLUSTER : v / 10;
+    }
+    for(auto assignment: {by_block, singletons, one, large, partial}) {
+        auto expected = brute_force_cost(&g, assignment);
+        auto cost = clustering_cost(&g, &assignment, 4u);
+        ASSERT_EQ(expected, cost.total());
+        auto csr_cost = clustering_cost(&csr, &assignment, 4u);
+        ASSERT_EQ(cost.positive_across, csr_cost.positive_across);
+        ASSERT_EQ(cost.negative_within, csr_cost.negative_within);
+        ASSERT_EQ(cost.clusters, csr_cost.clusters);
+    }
+    ASSERT_EQ(N / 10, clustering_cost(&csr, &by_block).clusters);
+    ASSERT_EQ(N / 10, clustering_cost(&csr, &large).clusters);
+    ASSERT_EQ(0ul, clustering_cost(&csr, &singletons).negative_within);
+    ASSERT_EQ(g.get_positive_m(), clustering_cost(&csr, &singletons).positive_across);
+}
+
+TEST(ClusteringCost, SkipsRemovedVerticesAndChecksTheSize) {
+    std::vector<std::pair<unsigned long, unsigned long>> edges = {{0ul, 1ul}, {1ul, 2ul}, {2ul, 3ul}};
+    Graph g;
+    g.load_from_edges(4ul, &edges);
+    g.remove_vertex(3ul);
+    std::vector<unsigned long> assignment = {1ul, 1ul, 1ul, 1ul};
+    auto cost = clustering_cost(&g, &assignment);
+    // {0, 2} is the only negative pair in the cluster
+    ASSERT_EQ(0ul, cost.positive_across);
+    ASSERT_EQ(1ul, cost.negative_within);
+    std::vector<unsigned long> short_assignment = {1ul};
+    ASSERT_THROW(clustering_cost(&g, &short_assignment), std::invalid_argument);
+}
+
+TEST(ClusteringCost, MissingVerticesAreSingletons) {
+    // a clustering file of the path 0-1-2-3 which lists only vertex 0
+    auto filename = ::testing::TempDir() + "clustering_cost_test.out";
+    {
+        std::ofstream file(filename);
+        file << "0\t1\n";
+    }
+    auto assignment = read_clustering(filename);
+    assignment->resize(4ul, SINGLETON_CLUSTER);
+    std::vector<std::pair<unsigned long, unsigned long>> edges = {{0ul, 1ul}, {1ul, 2ul}, {2ul, 3ul}};
+    GraphCSR csr(4ul, &edges);
+    auto cost = clustering_cost(&csr, assignment);
+    ASSERT_EQ(4ul, cost.clusters);
+    ASSERT_EQ(3ul, cost.positive_across);
+    ASSERT_EQ(0ul, cost.negative_within);
+    delete assignment;
+    std::remove(filename.c_str());
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
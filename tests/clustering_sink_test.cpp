@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include "../lib/ClusteringSink.h"
+
+static std::vector<unsigned long> sample_clustering(unsigned long n) {
+    // runs of the same cluster, with some large and decreasing labels
+    std::vector<unsigned long> clustering(n);
+    for(unsigned long v = 0ul; v < n; ++v)
+        clustering[v] = (v % 97 == 0) ? 18446744073709551615ul - v : v / 10;
+    return clustering;
+}
+
+static unsigned long file_size(std::string filename) {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    return static_cast<unsigned long>(in.tellg());
+}
+
+TEST(ClusteringSink, TsvKeepsTheTextFormat) {
+    std::vector<unsigned long> clustering = {3ul, 0ul, 1234567890123ul, 3ul};
+    auto sink = make_clustering_sink("tsv");
+    ASSERT_EQ(sink->extension(), ".out");
+    sink->write("clustering_sink_test.out", &clustering);
+    std::ifstream in("clustering_sink_test.out");
+    std::stringstream text;
+    text << in.rdbuf();
+    ASSERT_EQ(text.str(), "0\t3\n1\t0\n2\t1234567890123\n3\t3\n");
+    delete sink;
+    std::remove("clustering_sink_test.out");
+}
+
+TEST(ClusteringSink, AllFormatsRoundTrip) {
+    // larger than the buffer of the sinks
+    auto clustering = sample_clustering(300000ul);
+    for(std::string format: {"tsv", "binary", "varint"}) {
+        auto sink = make_clustering_sink(format);
+        auto filename = "clustering_sink_test" + sink->extension();
+        sink->write(filename, &clustering);
+        auto read = read_clustering(filename);
+        ASSERT_EQ(*read, clustering) << format;
+        delete read;
+        delete sink;
+        std::remove(filename.c_str());
+    }
+    std::vector<unsigned long> empty;
+    auto sink = make_clustering_sink("varint");
+    sink->write("clustering_sink_test.vz", &empty);
+    auto read = read_clustering("clustering_sink_test.vz");
+    ASSERT_TRUE(read->empty());
+    delete read;
+    delete sink;
+    std::remove("clustering_sink_test.vz");
+}
+
+TEST(ClusteringSink, VarintIsCompact) {
+    std::vector<unsigned long> clustering(100000ul);
+    for(unsigned long v = 0ul; v < clustering.size(); ++v)
+        clustering[v] = v / 50;
+    auto sink = make_clustering_sink("varint");
+    sink->write("clustering_sink_test.vz", &clustering);
+    // one byte per vertex after the 16-byte header
+    ASSERT_EQ(file_size("clustering_sink_test.vz"), 16ul + clustering.size());
+    delete sink;
+    std::remove("clustering_sink_test.vz");
+}
+
+TEST(ClusteringSink, RejectsBadInput) {
+    ASSERT_THROW(make_clustering_sink("csv"), std::invalid_argument);
+    ASSERT_THROW(read_clustering("clustering_sink_test_missing.bin"), std::invalid_argument);
+    auto clustering = sample_clustering(1000ul);
+    auto sink = make_clustering_sink("binary");
+    sink->write("clustering_sink_test.bin", &clustering);
+    {
+        // drops the last label
+        std::ifstream in("clustering_sink_test.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("clustering_sink_test.bin", std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size() - 8);
+    }
+    ASSERT_THROW(read_clustering("clustering_sink_test.bin"), std::runtime_error);
+    delete sink;
+    std::remove("clustering_sink_test.bin");
+}
+
+/**
+ * @brief the labels of a union-find: 1 to the number of clusters in the
+ * order of the smallest vertex of every cluster
+ */
+static std::vector<unsigned long> canonical(const std::vector<unsigned long> &clustering) {
+    std::map<unsigned long, unsigned long> label_of;
+    std::vector<unsigned long> labels(clustering.size());
+    for(unsigned long v = 0ul; v < clustering.size(); ++v)
+        labels[v] = label_of.emplace(clustering[v], label_of.size() + 1).first->second;
+    return labels;
+}
+
+TEST(ClusteringChangeLog, ReconstructsEveryLevel) {
+    const unsigned long N = 5000ul;
+    std::vector<std::vector<unsigned long>> levels;
+    // singletons, then merges of neighbouring blocks, then a split and a move
+    std::vector<unsigned long> clustering(N);
+    for(unsigned long v = 0ul; v < N; ++v)
+        clustering[v] = v + 1;
+    levels.push_back(clustering);
+    for(unsigned long block: {10ul, 100ul, 1000ul}) {
+        for(unsigned long v = 0ul; v < N; ++v)
+            clustering[v] = v / block + 1;
+        levels.push_back(clustering);
+    }
+    for(unsigned long v = 0ul; v < N; v += 7)
+        clustering[v] = 1000000ul + v % 3;
+    levels.push_back(clustering);
+    levels.push_back(sample_clustering(N));
+    levels.push_back(sample_clustering(N));
+    ClusteringChangeLogWriter writer("clustering_sink_test.hcl", N);
+    for(unsigned long l = 0ul; l < levels.size(); ++l)
+        writer.add_level(0.1 * l, &levels[l]);
+    std::vector<unsigned long> too_short(N - 1, 1ul);
+    ASSERT_THROW(writer.add_level(1.0, &too_short), std::invalid_argument);
+    writer.close();
+    ASSERT_TRUE(ClusteringChangeLog::is_change_log_file("clustering_sink_test.hcl"));
+    ClusteringChangeLog log("clustering_sink_test.hcl");
+    ASSERT_EQ(log.get_n(), N);
+    ASSERT_EQ(log.get_num_levels(), levels.size());
+    auto all = log.clusterings();
+    for(unsigned long l = 0ul; l < levels.size(); ++l) {
+        ASSERT_DOUBLE_EQ(log.get_eps(l), 0.1 * l);
+        auto level = log.clustering(l);
+        ASSERT_EQ(*level, canonical(levels[l])) << "level " << l;
+        ASSERT_EQ(*(*all)[l], *level) << "level " << l;
+        delete level;
+    }
+    for(auto level: *all)
+        delete level;
+    delete all;
+    ASSERT_THROW(log.clustering(levels.size()), std::out_of_range);
+    std::remove("clustering_sink_test.hcl");
+}
+
+TEST(ClusteringChangeLog, StoresOnlyTheChanges) {
+    const unsigned long N = 100000ul;
+    std::vector<unsigned long> clustering(N);
+    ClusteringChangeLogWriter writer("clustering_sink_test.hcl", N);
+    for(unsigned long block = 2ul; block <= 1024ul; block *= 2) {
+        for(unsigned long v = 0ul; v < N; ++v)
+            clustering[v] = v / block + 1;
+        writer.add_level(1.0 / block, &clustering);
+    }
+    // the same level again costs a few bytes
+    writer.add_level(0.0, &clustering);
+    writer.close();
+    // every merge of two blocks is a single relabel
+    ASSERT_EQ(writer.get_num_changes(), N - (N + 1023) / 1024);
+    ASSERT_LT(file_size("clustering_sink_test.hcl"), N * 3);
+    ClusteringChangeLog log("clustering_sink_test.hcl");
+    auto last = log.clustering(log.get_num_levels() - 1);
+    ASSERT_EQ(*last, clustering);
+    delete last;
+    std::remove("clustering_sink_test.hcl");
+    ASSERT_THROW(ClusteringChangeLog("clustering_sink_test_missing.hcl"), std::invalid_argument);
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <cmath>
+#include "../lib/NaiveCorrelationClustering.h"
+#include "../lib/IndexBasedCorrelationClustering.h"
+#include "TestGraphs.h"
+
+// built with -DNAO_COMPACT_KEYS by its target, and exact in any other build
+
+TEST(CompactKeys, ThresholdIsExactAtTheNonAgreements) {
+    std::mt19937 rng(5u);
+    std::uniform_int_distribution<unsigned long> random_den(1ul, 100000ul);
+    for(unsigned long step = 0ul; step < 100000ul; ++step) {
+        auto den = random_den(rng);
+        auto num = std::uniform_int_distribution<unsigned long>(0ul, 2 * den - 1)(rng);
+        auto key = to_nao_key(na_key(num, den));
+        double na = static_cast<double>(num) / den;
+        // not below an eps equal to it, and below an eps clearly above it,
+        // in the range where the thresholds are exact
+        if (na <= std::ldexp(1.0, -9))
+            continue;
+        ASSERT_FALSE(key < to_nao_threshold(eps_to_key(na))) << num << "/" << den;
+        ASSERT_TRUE(key < to_nao_threshold(eps_to_key(na + 1e-6))) << num << "/" << den;
+    }
+}
+
+TEST(CompactKeys, SameClusteringAsNaiveAtTheNonAgreements) {
+    Graph g;
+    load_test_graph(&g);
+    NaiveCorrelationClustering naive_cc(&g);
+    IndexBasedCorrelationClustering index_cc(&g);
+    // every eps at which a clustering may change, as the auto-batch schedules
+    auto all_eps = index_cc.get_all_eps();
+    std::vector<double> eps_values = {1.0 / 3.0, 2.0 / 3.0, 0.8, 6.0 / 7.0};
+    for(auto &e: *all_eps)
+        eps_values.push_back(e.first);
+    delete all_eps;
+    for(auto eps: eps_values) {
+        auto naive_output = naive_cc.query(eps);
+        auto index_output = index_cc.query(eps);
+        ASSERT_EQ(*naive_output, *index_output) << "eps = " << eps;
+        delete naive_output;
+        delete index_output;
+    }
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include "../lib/EdgeListParser.h"
+#include "../lib/Graph.h"
+#include "../lib/GraphCSR.h"
+
+std::string write_temp_file(std::string name, std::string content) {
+    auto filename = ::testing::TempDir() + name;
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    file << content;
+    return filename;
+}
+
+TEST(EdgeListParser, ParsesHeaderAndEdgesInOrder) {
+    auto filename = write_temp_file("edge_list_parser_small.txt",
+        "5 4\n0 1\r\n# a comment\n\n1  2\n3\t4\n2 0");
+    for(unsigned int threads: {1u, 3u, 16u}) {
+        EdgeListParser parser(filename, threads);
+        ASSERT_EQ(5lu, parser.get_n());
+        ASSERT_EQ(4lu, parser.get_declared_m());
+        std::vector<std::pair<unsigned long, unsigned long>> expected = {
+            {0lu, 1lu}, {1lu, 2lu}, {3lu, 4lu}, {2lu, 0lu}
+        };
+        ASSERT_EQ(expected, *parser.get_edges());
+    }
+    std::remove(filename.c_str());
+}
+
+TEST(EdgeListParser, RejectsMalformedLines) {
+    auto filename = write_temp_file("edge_list_parser_malformed.txt", "3 2\n0 1\n1 x\n");
+    ASSERT_THROW(EdgeListParser parser(filename, 2u), std::runtime_error);
+    filename = write_temp_file("edge_list_parser_malformed.txt", "3 2\n0 1 2\n");
+    ASSERT_THROW(EdgeListParser parser(filename, 2u), std::runtime_error);
+    std::remove(filename.c_str());
+    ASSERT_THROW(EdgeListParser parser(filename), std::invalid_argument);
+}
+
+TEST(EdgeListParser, GraphIgnoresDuplicatesSelfLoopsAndRejectsOutOfRange) {
+    auto filename = write_temp_file("edge_list_parser_graph.txt", "4 4\n0 1\n1 0\n2 2\n1 3\n1 3\n");
+    Graph g;
+    g.load_from_file(filename);
+    ASSERT_EQ(4lu, g.get_n());
+    ASSERT_EQ(2lu, g.get_positive_m());
+    std::vector<vertex_id_t> expected = {0lu, 3lu};
+    ASSERT_EQ(expected, *g.get_neighborhood(1));
+    filename = write_temp_file("edge_list_parser_graph.txt", "2 1\n0 2\n");
+    Graph h;
+    ASSERT_THROW(h.load_from_file(filename), std::out_of_range);
+    std::remove(filename.c_str());
+}
+
+TEST(EdgeListParser, SameResultForAnyNumberOfThreads) {
+    // a few megabytes of random edges, so every thread gets many chunks
+    const unsigned long N = 50000ul, M = 400000ul;
+    std::mt19937_64 rng(11ul);
+    std::uniform_int_distribution<unsigned long> vertex(0ul, N - 1);
+    std::ostringstream content;
+    content << N << " " << M << "\n";
+    for(unsigned long i = 0ul; i < M; ++i) {
+        if (i % 1000ul == 0ul)
+            content << "# a comment\n";
+        content << vertex(rng) << (i % 3ul == 0ul ? "\t" : " ") << vertex(rng) << (i % 7ul == 0ul ? "\r\n" : "\n");
+    }
+    auto input_file = write_temp_file("edge_list_parser_large.txt", content.str());
+    EdgeListParser sequential(input_file, 1u);
+    EdgeListParser parallel(input_file, 4u);
+    ASSERT_GT(parallel.get_bytes(), 4000000ul);
+    ASSERT_EQ(sequential.get_n(), parallel.get_n());
+    ASSERT_EQ(M, parallel.get_edges()->size());
+    ASSERT_EQ(*sequential.get_edges(), *parallel.get_edges());
+    // the graph and the bulk CSR built from the parsed edges agree
+    Graph g;
+    g.load_from_file(input_file);
+    GraphCSR csr(parallel.get_n(), parallel.get_edges());
+    ASSERT_EQ(g.get_n(), csr.get_n());
+    ASSERT_EQ(g.get_positive_m(), csr.get_positive_m());
+    for(unsigned long i = 0; i < g.get_n(); ++i) {
+        auto neigh = g.get_neighborhood(i);
+        ASSERT_EQ(neigh->size(), csr.deg_positive(i));
+        ASSERT_TRUE(std::equal(neigh->begin(), neigh->end(), csr.neighborhood_begin(i)));
+    }
+    std::remove(input_file.c_str());
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../lib/EdgeOrder.h"
+#include "TestGraphs.h"
+
+class EdgeOrderTest : public ::testing::Test {
+    protected:
+        Graph *g;
+        GraphCSR *csr;
+        NAOArena *arena;
+        EdgeOrder *order;
+
+        void SetUp() override {
+            this->g = new Graph();
+            load_test_graph(this->g);
+            this->csr = new GraphCSR(this->g);
+            this->arena = new NAOArena(this->csr, 4u);
+            this->order = new EdgeOrder(this->arena, 4u);
+        }
+
+        void TearDown() override {
+            delete this->order;
+            delete this->arena;
+            delete this->csr;
+            delete this->g;
+        }
+
+        void expect_agreeing_as_naos(double eps) {
+            auto threshold = to_nao_threshold(eps_to_key(eps));
+            std::vector<std::pair<unsigned long, unsigned long>> expected, actual;
+            for(unsigned long u = 0ul; u < this->arena->get_n(); ++u) {
+                if (!this->arena->has(u))
+                    continue;
+                for(unsigned long k = 0ul; k < this->arena->size(u) && this->arena->keys_of(u)[k] < threshold; ++k) {
+                    if (u < this->arena->ids_of(u)[k])
+                        expected.push_back(std::make_pair(u, this->arena->ids_of(u)[k]));
+                }
+            }
+            std::vector<std::vector<std::pair<unsigned long, unsigned long>>> found(4);
+            this->order->for_each_agreeing(threshold, [&found](unsigned long u, unsigned long v, unsigned int t) {
+                found[t].push_back(std::make_pair(std::min(u, v), std::max(u, v)));
+            }, 4u);
+            for(auto &found_t: found)
+                actual.insert(actual.end(), found_t.begin(), found_t.end());
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            ASSERT_EQ(expected, actual) << "eps = " << eps;
+        }
+};
+
+TEST_F(EdgeOrderTest, PrefixIsTheAgreeingEdges) {
+    ASSERT_EQ(this->g->get_positive_m(), this->order->size());
+    for(auto eps: {0.0, 0.1, 0.3, 0.5, 0.7, 1.0, 1.99}) {
+        this->expect_agreeing_as_naos(eps);
+        auto threshold = to_nao_threshold(eps_to_key(eps));
+        ASSERT_EQ(this->order->size(), this->order->prefix_length(threshold)
+            + this->order->size() - this->order->prefix_length(threshold));
+    }
+    ASSERT_EQ(0ul, this->order->prefix_length(0u));
+    ASSERT_EQ(this->order->size(), this->order->prefix_length(to_nao_threshold(NA_KEY_ALL)));
+    ASSERT_EQ(0ul, this->order->changed_entries());
+}
+
+TEST_F(EdgeOrderTest, FollowsChangedNAOs) {
+    // changing some entries of two neighbors, in both of their NAOs
+    const unsigned long U = 0ul;
+    auto v = static_cast<unsigned long>(this->arena->ids_of(U)[0]);
+    auto key = na_key(1ul, 3ul);
+    this->arena->update_existing(U, {{v, key}});
+    this->arena->update_existing(v, {{U, key}});
+    // removing an edge and adding a new vertex with an edge
+    auto w = static_cast<unsigned long>(this->arena->ids_of(U)[this->arena->size(U) - 1]);
+    this->arena->remove(U, w);
+    this->arena->remove(w, U);
+    auto x = this->arena->add_vertex();
+    this->arena->insert(x, U, na_key(1ul, 10ul));
+    this->arena->insert(U, x, na_key(1ul, 10ul));
+    ASSERT_GT(this->order->changed_entries(), 0ul);
+    for(auto eps: {0.05, 0.2, 0.34, 0.5, 1.0, 1.99})
+        this->expect_agreeing_as_naos(eps);
+    this->order->rebuild(4u);
+    ASSERT_EQ(0ul, this->order->changed_entries());
+    ASSERT_EQ(this->g->get_positive_m(), this->order->size());
+    for(auto eps: {0.05, 0.2, 0.34, 0.5, 1.0, 1.99})
+        this->expect_agreeing_as_naos(eps);
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include"../lib/EdgeSupport.h"
+#include "TestGraphs.h"
+
+class EdgeSupportTest : public ::testing::Test {
+    protected:
+        Graph *g;
+        GraphCSR *csr;
+
+        void SetUp() override {
+            this->g = new Graph();
+            load_test_graph(this->g);
+            this->csr = new GraphCSR(this->g);
+        }
+
+        void TearDown() override {
+            delete this->csr;
+            delete this->g;
+        }
+};
+
+TEST_F(EdgeSupportTest, NonAgreementsEqualIntersections) {
+    for(unsigned int threads: {1u, 4u}) {
+        auto support = new EdgeSupport(this->csr, threads);
+        for(unsigned long i = 0; i < csr->get_n(); ++i) {
+            for(auto slot = csr->get_offset(i); slot < csr->get_offset(i + 1); ++slot) {
+                auto j = csr->neighbor_at(slot);
+                ASSERT_DOUBLE_EQ(g->non_agreement(i, j), support->non_agreement_at(slot));
+                ASSERT_DOUBLE_EQ(g->non_agreement(i, j), support->non_agreement(j, i));
+            }
+        }
+        delete support;
+    }
+}
+
+TEST(EdgeSupport, TrianglesOfACompleteGraph) {
+    // in K_5 every edge is in 3 triangles: NA = (4 + 4 - 2 * 3) / (4 + 1)
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    for(unsigned long u = 0ul; u < 5ul; ++u)
+        for(unsigned long v = u + 1; v < 5ul; ++v)
+            edges.push_back(std::make_pair(u, v));
+    edges.push_back(std::make_pair(4ul, 5ul));
+    GraphCSR csr(6ul, &edges);
+    EdgeSupport support(&csr);
+    ASSERT_DOUBLE_EQ(0.4, support.non_agreement(0ul, 1ul));
+    // {4,5} has no common neighbor: (5 + 1 - 0) / (5 + 1)
+    ASSERT_DOUBLE_EQ(1.0, support.non_agreement(5ul, 4ul));
+    ASSERT_DOUBLE_EQ(INVALID_NON_AGREEMENT, support.non_agreement(0ul, 5ul));
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <cstddef>
+#include"../lib/GraphCSR.h"
+#include "TestGraphs.h"
+
+std::string write_text_file(std::string name) {
+    auto filename = ::testing::TempDir() + name;
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "3 2\n0 1\n1 2\n";
+    return filename;
+}
+
+class GraphCSRTest : public ::testing::Test {
+    protected:
+        Graph *g;
+        GraphCSR *csr;
+
+        void SetUp() override {
+            this->g = new Graph();
+            load_test_graph(this->g);
+            this->csr = new GraphCSR(this->g);
+        }
+
+        void TearDown() override {
+            delete this->csr;
+            delete this->g;
+        }
+};
+
+TEST_F(GraphCSRTest, SameNeighborhoodsAsGraph) {
+    ASSERT_EQ(g->get_n(), csr->get_n());
+    ASSERT_EQ(g->get_positive_m(), csr->get_positive_m());
+    for(unsigned long i = 0; i < g->get_n(); ++i) {
+        auto neigh = g->get_neighborhood(i);
+        ASSERT_EQ(neigh->size(), csr->deg_positive(i));
+        ASSERT_TRUE(std::equal(neigh->begin(), neigh->end(), csr->neighborhood_begin(i)));
+    }
+}
+
+TEST_F(GraphCSRTest, NonAgreementEqualsGraph) {
+    for(unsigned long i = 0; i < g->get_n(); ++i) {
+        for(auto j: *(g->get_neighborhood(i))) {
+            ASSERT_DOUBLE_EQ(g->non_agreement(i, j), csr->non_agreement(i, j));
+        }
+    }
+    ASSERT_DOUBLE_EQ(INVALID_NON_AGREEMENT, csr->non_agreement(0lu, 0lu));
+}
+
+TEST_F(GraphCSRTest, SlotsPointToNeighbors) {
+    for(unsigned long i = 0; i < g->get_n(); ++i) {
+        for(auto j: *(g->get_neighborhood(i))) {
+            auto slot = csr->where_is_in_neigh_plus(i, j);
+            ASSERT_EQ(j, csr->neighbor_at(slot));
+            ASSERT_TRUE(csr->is_in_neigh_plus(j, i));
+        }
+    }
+    ASSERT_EQ(2 * csr->get_positive_m(), csr->where_is_in_neigh_plus(0lu, 0lu));
+}
+
+TEST_F(GraphCSRTest, BulkBuilderMatchesGraph) {
+    // every edge in both directions, duplicated, plus self-loops
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    for(unsigned long i = 0; i < g->get_n(); ++i) {
+        edges.push_back(std::make_pair(i, i));
+        for(auto j: *(g->get_neighborhood(i))) {
+            edges.push_back(std::make_pair(i, j));
+            edges.push_back(std::make_pair(j, i));
+        }
+    }
+    for(unsigned int threads: {1u, 4u}) {
+        auto bulk = new GraphCSR(g->get_n(), &edges, threads);
+        ASSERT_EQ(csr->get_positive_m(), bulk->get_positive_m());
+        for(unsigned long i = 0; i < g->get_n(); ++i) {
+            ASSERT_EQ(csr->deg_positive(i), bulk->deg_positive(i));
+            ASSERT_TRUE(std::equal(csr->neighborhood_begin(i), csr->neighborhood_end(i), bulk->neighborhood_begin(i)));
+        }
+        delete bulk;
+    }
+}
+
+TEST(GraphCSR, BulkBuilderRejectsOutOfRangeEdges) {
+    std::vector<std::pair<unsigned long, unsigned long>> edges = {std::make_pair(0lu, 1lu), std::make_pair(1lu, 3lu)};
+    ASSERT_THROW(new GraphCSR(3lu, &edges), std::invalid_argument);
+}
+
+TEST(GraphCSR, DeletedVerticesHaveEmptyNeighborhoods) {
+    Graph g;
+    for(unsigned int i = 0; i < 4; ++i)
+        g.add_vertex();
+    g.add_positive_edge(0, 1);
+    g.add_positive_edge(1, 2);
+    g.add_positive_edge(2, 3);
+    g.remove_vertex(2);
+    GraphCSR csr(&g);
+    ASSERT_EQ(4lu, csr.get_n());
+    ASSERT_EQ(1lu, csr.get_positive_m());
+    ASSERT_EQ(0lu, csr.deg_positive(2));
+    ASSERT_EQ(0lu, csr.deg_positive(3));
+}
+
+TEST_F(GraphCSRTest, BinaryFileRoundTrip) {
+    auto binary_file = ::testing::TempDir() + "graph_csr_test.csr";
+    csr->save_to_binary_file(binary_file);
+    ASSERT_TRUE(GraphCSR::is_binary_file(binary_file));
+    auto text_file = write_text_file("graph_csr_test.txt");
+    ASSERT_FALSE(GraphCSR::is_binary_file(text_file));
+    std::remove(text_file.c_str());
+    auto mapped = new GraphCSR(binary_file, true);
+    ASSERT_TRUE(mapped->is_mapped());
+    ASSERT_EQ(csr->get_n(), mapped->get_n());
+    ASSERT_EQ(csr->get_positive_m(), mapped->get_positive_m());
+    for(unsigned long i = 0; i < csr->get_n(); ++i) {
+        ASSERT_EQ(csr->deg_positive(i), mapped->deg_positive(i));
+        ASSERT_TRUE(std::equal(csr->neighborhood_begin(i), csr->neighborhood_end(i), mapped->neighborhood_begin(i)));
+    }
+    // a graph loaded from the mapped arrays is the same as the original one
+    Graph loaded;
+    loaded.load_from_adjacency(mapped->get_n(), mapped->get_offsets(), mapped->get_neighbors());
+    ASSERT_EQ(g->get_n(), loaded.get_n());
+    ASSERT_EQ(g->get_positive_m(), loaded.get_positive_m());
+    for(unsigned long i = 0; i < g->get_n(); ++i)
+        ASSERT_EQ(*(g->get_neighborhood(i)), *(loaded.get_neighborhood(i)));
+    delete mapped;
+    std::remove(binary_file.c_str());
+    // the arrays are checked while they are copied
+    std::vector<unsigned long> offsets = {0ul, 1ul, 2ul, 1ul};
+    std::vector<vertex_id_t> neighbors = {1ul, 0ul};
+    ASSERT_THROW(loaded.load_from_adjacency(3ul, offsets.data(), neighbors.data()), std::invalid_argument);
+    offsets = {0ul, 1ul, 2ul};
+    neighbors = {2ul, 0ul};
+    ASSERT_THROW(loaded.load_from_adjacency(2ul, offsets.data(), neighbors.data()), std::out_of_range);
+}
+
+TEST_F(GraphCSRTest, BinaryFileRejectsCorruption) {
+    auto binary_file = ::testing::TempDir() + "graph_csr_test_corrupt.csr";
+    csr->save_to_binary_file(binary_file);
+    {
+        // flipping one id of the neighbors array
+        std::fstream file(binary_file, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-static_cast<long>(sizeof(unsigned long)), std::ios::end);
+        unsigned long corrupted = csr->get_n() + 7;
+        file.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+    }
+    ASSERT_NO_THROW(delete new GraphCSR(binary_file));
+    ASSERT_THROW(new GraphCSR(binary_file, true), std::runtime_error);
+    {
+        // the same neighbor id out of range, without a checksum
+        std::fstream file(binary_file, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(offsetof(GraphCSRFileHeader, checksum));
+        std::uint64_t no_checksum = 0ull;
+        file.write(reinterpret_cast<const char*>(&no_checksum), sizeof(no_checksum));
+    }
+    ASSERT_THROW(new GraphCSR(binary_file, true), std::runtime_error);
+    {
+        // an offset in the middle past the end of the neighbors array
+        std::fstream file(binary_file, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(GraphCSRFileHeader) + (csr->get_n() / 2) * sizeof(unsigned long));
+        unsigned long corrupted = 4 * csr->get_positive_m();
+        file.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+    }
+    ASSERT_THROW(new GraphCSR(binary_file), std::runtime_error);
+    {
+        // a size which does not match the header
+        std::ofstream file(binary_file, std::ios::out | std::ios::binary | std::ios::app);
+        file.write("x", 1);
+    }
+    ASSERT_THROW(new GraphCSR(binary_file), std::runtime_error);
+    auto text_file = write_text_file("graph_csr_test_corrupt.txt");
+    ASSERT_THROW(new GraphCSR(text_file), std::runtime_error);
+    std::remove(text_file.c_str());
+    std::remove(binary_file.c_str());
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
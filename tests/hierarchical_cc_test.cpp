@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../lib/IndexBasedCorrelationClustering.h"
+#include "../lib/HierarchicalCorrelationClustering.h"
+#include "TestGraphs.h"
+
+class HierarchicalCCTest : public ::testing::Test {
+    protected:
+        Graph *g;
+        IndexBasedCorrelationClustering *index_cc;
+        HierarchicalCorrelationClustering *hierarchical_cc;
+
+        void SetUp() override {
+            this->g = new Graph();
+            load_test_graph(this->g);
+            this->index_cc = new IndexBasedCorrelationClustering(this->g);
+            this->hierarchical_cc = new HierarchicalCorrelationClustering(this->g);
+        }
+
+        void TearDown() override {
+            delete this->hierarchical_cc;
+            delete this->index_cc;
+            delete this->g;
+        }
+};
+
+TEST_F(HierarchicalCCTest, Same_Clustering_As_Index_On_Every_Level) {
+    std::vector<double> eps_schedule;
+    for(double eps = 0.05; eps < 2.0; eps += 0.05)
+        eps_schedule.push_back(eps);
+    // levels exactly at the non-agreements of some edges, tied with them
+    for(unsigned long i = 0ul; i < this->g->get_n(); i += 20ul)
+        for(auto j: *(this->g->get_neighborhood(i)))
+            eps_schedule.push_back(this->g->non_agreement(i, j));
+    std::sort(eps_schedule.begin(), eps_schedule.end());
+    eps_schedule.push_back(eps_schedule.back()); // repeated levels are allowed
+    auto outputs = this->hierarchical_cc->query(eps_schedule);
+    ASSERT_EQ(eps_schedule.size(), outputs->size());
+    for(unsigned long level = 0ul; level < eps_schedule.size(); ++level) {
+        auto index_output = this->index_cc->query(eps_schedule[level]);
+        ASSERT_EQ(index_output->size(), (*outputs)[level]->size());
+        for(unsigned long i = 0ul; i < index_output->size(); ++i) {
+            ASSERT_EQ(index_output->at(i), (*outputs)[level]->at(i)) << "eps = " << eps_schedule[level];
+        }
+        delete index_output;
+        delete (*outputs)[level];
+    }
+    delete outputs;
+}
+
+TEST_F(HierarchicalCCTest, Unsorted_Schedule_Throws) {
+    std::vector<double> eps_schedule = {0.5, 0.1};
+    ASSERT_THROW(this->hierarchical_cc->query(eps_schedule), std::invalid_argument);
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
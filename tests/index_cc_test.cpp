@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <stdexcept>
 #include <algorithm>
+#include <random>
+#include <map>
 
 #include "../lib/NaiveCorrelationClustering.h"
 #include "../lib/IndexBasedCorrelationClustering.h"
@@ -88,6 +90,195 @@ TEST_F(IndexCCTest, Same_Deleted_Edges) {
     ASSERT_EQ(naive_g->get_positive_m(), index_g->get_positive_m());
 }
 
+TEST_F(IndexCCTest, DynamicUpdatesMatchRebuild) {
+    this->index_cc->add_edge(1ul, 2ul);
+    this->index_cc->add_edge(5ul, 7ul);
+    this->index_cc->add_edge(2ul, 3ul);
+    this->index_cc->remove_edge(1ul, 0ul);
+    this->index_cc->remove_edge(3ul, 0ul);
+    auto new_vertex = this->index_cc->add_vertex();
+    this->index_cc->add_edge(new_vertex, 0ul);
+    this->index_cc->add_edge(new_vertex, 1ul);
+    this->index_cc->remove_vertex(10ul);
+    ASSERT_THROW(this->index_cc->add_edge(10ul, 0ul), std::logic_error);
+    // every NAO must be identical to the one built from scratch
+    auto index_g = this->index_cc->get_g();
+    for(unsigned long i = 0ul; i <= new_vertex; ++i) {
+        auto neigh = index_g->get_neighborhood(i);
+        if (neigh == nullptr)
+            continue;
+        auto nao = this->index_cc->get_nao(i);
+        ASSERT_EQ(neigh->size(), nao->get_nao()->size());
+        for(auto j: *neigh) {
+            ASSERT_DOUBLE_EQ(index_g->non_agreement(i, j), nao->query_na(j));
+        }
+    }
+    // and so must be the clustering
+    auto rebuilt_cc = new IndexBasedCorrelationClustering(index_g);
+    auto index_output = this->index_cc->query(eps);
+    auto rebuilt_output = rebuilt_cc->query(eps);
+    ASSERT_EQ(rebuilt_output->size(), index_output->size());
+    for(unsigned long i = 0ul; i < index_output->size(); ++i) {
+        ASSERT_EQ(rebuilt_output->at(i), index_output->at(i));
+    }
+    delete rebuilt_cc;
+}
+
+/**
+ * @brief a random valid batch over the first vertices of g, with repeated and
+ * opposing operations on the same edges, new vertices and removed vertices
+ */
+std::vector<Update> random_batch(Graph *g, unsigned long size, unsigned int seed) {
+    std::mt19937 rng(seed);
+    unsigned long id_bound = g->get_id_bound();
+    unsigned long range = std::min(id_bound, 200ul);
+    std::vector<bool> removed(id_bound, false);
+    for(unsigned long v = 0ul; v < id_bound; ++v)
+        removed[v] = g->get_neighborhood(v) == nullptr;
+    std::vector<Update> batch;
+    while (batch.size() < size) {
+        auto kind = rng() % 20;
+        auto u = rng() % range, v = rng() % range;
+        if (kind == 0) {
+            batch.push_back({ADD_VERTEX, 0ul, 0ul, 0.0});
+            removed.push_back(false);
+            range = removed.size();
+        }
+        else if (kind == 1 && !removed[u]) {
+            batch.push_back({REMOVE_VERTEX, u, 0ul, 0.0});
+            removed[u] = true;
+        }
+        else if (!removed[u] && !removed[v]) {
+            batch.push_back({(kind % 2) ? ADD_EDGE : REMOVE_EDGE, u, v, 0.0});
+            if (kind == 2) // an opposing operation right after
+                batch.push_back({ADD_EDGE, u, v, 0.0});
+        }
+    }
+    return batch;
+}
+
+TEST_F(IndexCCTest, BatchUpdatesMatchSequential) {
+    for(bool defer: {false, true}) {
+        auto batch_cc = new IndexBasedCorrelationClustering(this->g);
+        auto sequential_cc = new IndexBasedCorrelationClustering(this->g);
+        for(unsigned int round = 0u; round < 3u; ++round) {
+            auto batch = random_batch(sequential_cc->get_g(), 500ul, round);
+            batch_cc->apply_batch(&batch, defer);
+            for(auto &update: batch) {
+                switch (update.type) {
+                    case ADD_EDGE: sequential_cc->add_edge(update.u, update.v); break;
+                    case REMOVE_EDGE: sequential_cc->remove_edge(update.u, update.v); break;
+                    case ADD_VERTEX: sequential_cc->add_vertex(); break;
+                    case REMOVE_VERTEX: sequential_cc->remove_vertex(update.u); break;
+                    default: break;
+                }
+            }
+        }
+        auto batch_g = batch_cc->get_g();
+        auto sequential_g = sequential_cc->get_g();
+        ASSERT_EQ(sequential_g->get_id_bound(), batch_g->get_id_bound());
+        ASSERT_EQ(sequential_g->get_positive_m(), batch_g->get_positive_m());
+        auto batch_output = batch_cc->query(eps);
+        auto sequential_output = sequential_cc->query(eps);
+        ASSERT_EQ(*sequential_output, *batch_output);
+        for(unsigned long i = 0ul; i < batch_g->get_id_bound(); ++i) {
+            auto neigh = sequential_g->get_neighborhood(i);
+            if (neigh == nullptr) {
+                ASSERT_EQ(nullptr, batch_g->get_neighborhood(i));
+                continue;
+            }
+            ASSERT_EQ(*neigh, *(batch_g->get_neighborhood(i)));
+            auto nao = batch_cc->get_nao(i);
+            ASSERT_EQ(neigh->size(), nao->get_nao()->size());
+            ASSERT_TRUE(std::is_sorted(nao->get_nao()->begin(), nao->get_nao()->end(), sort_order));
+            for(auto j: *neigh) {
+                ASSERT_DOUBLE_EQ(batch_g->non_agreement(i, j), nao->query_na(j));
+            }
+        }
+        delete sequential_output;
+        delete batch_output;
+        delete sequential_cc;
+        delete batch_cc;
+    }
+}
+
+TEST_F(IndexCCTest, InvalidBatchChangesNothing) {
+    auto m = this->index_cc->get_g()->get_positive_m();
+    std::vector<Update> batch = {
+        {ADD_EDGE, 1ul, 2ul, 0.0},
+        {REMOVE_VERTEX, 3ul, 0ul, 0.0},
+        {ADD_EDGE, 3ul, 4ul, 0.0}
+    };
+    ASSERT_THROW(this->index_cc->apply_batch(&batch), std::logic_error);
+    ASSERT_EQ(m, this->index_cc->get_g()->get_positive_m());
+    ASSERT_NE(nullptr, this->index_cc->get_g()->get_neighborhood(3ul));
+    // an insert cancelled by a delete leaves the graph as it was
+    batch = {{ADD_VERTEX, 0ul, 0ul, 0.0}};
+    auto new_vertex = this->index_cc->get_g()->get_id_bound();
+    batch.push_back({ADD_EDGE, new_vertex, 0ul, 0.0});
+    batch.push_back({REMOVE_EDGE, 0ul, new_vertex, 0.0});
+    this->index_cc->apply_batch(&batch);
+    ASSERT_EQ(m, this->index_cc->get_g()->get_positive_m());
+    ASSERT_EQ(0ul, this->index_cc->get_g()->deg_positive(new_vertex));
+}
+
+TEST_F(IndexCCTest, CompactionRenumbersTheLiveVertices) {
+    for(unsigned int round = 0u; round < 3u; ++round) {
+        auto batch = random_batch(this->index_cc->get_g(), 500ul, round);
+        this->index_cc->apply_batch(&batch, true);
+    }
+    auto g = this->index_cc->get_g();
+    auto n = g->get_n();
+    auto id_bound = g->get_id_bound();
+    ASSERT_LT(n, id_bound);
+    auto before = this->index_cc->query(eps);
+    auto old_to_new = this->index_cc->compact_ids();
+    ASSERT_EQ(id_bound, old_to_new->size());
+    ASSERT_EQ(n, g->get_n());
+    ASSERT_EQ(n, g->get_id_bound());
+    ASSERT_EQ(n, this->index_cc->get_naos()->get_n());
+    auto after = this->index_cc->query(eps);
+    ASSERT_EQ(n, after->size());
+    // the same partition of the live vertices
+    std::map<unsigned long, unsigned long> cluster_after, cluster_before;
+    unsigned long next = 0ul;
+    for(unsigned long v = 0ul; v < id_bound; ++v) {
+        if ((*old_to_new)[v] == REMOVED_VERTEX_ID)
+            continue;
+        ASSERT_EQ(next++, (*old_to_new)[v]);
+        auto a = cluster_after.emplace(before->at(v), after->at((*old_to_new)[v])).first->second;
+        auto b = cluster_before.emplace(after->at((*old_to_new)[v]), before->at(v)).first->second;
+        ASSERT_EQ(a, after->at((*old_to_new)[v]));
+        ASSERT_EQ(b, before->at(v));
+    }
+    ASSERT_EQ(n, next);
+    // the NAOs and the clustering are the ones of the compacted graph
+    for(unsigned long v = 0ul; v < n; ++v) {
+        auto neigh = g->get_neighborhood(v);
+        auto nao = this->index_cc->get_nao(v);
+        ASSERT_EQ(neigh->size(), nao->get_nao()->size());
+        for(auto u: *neigh)
+            ASSERT_DOUBLE_EQ(g->non_agreement(v, u), nao->query_na(u));
+    }
+    auto naive_cc = new NaiveCorrelationClustering(g);
+    auto naive_output = naive_cc->query(eps);
+    ASSERT_EQ(*naive_output, *after);
+    // and the index keeps working on the new ids
+    auto batch = random_batch(g, 500ul, 7u);
+    this->index_cc->apply_batch(&batch);
+    auto updated = this->index_cc->query(eps);
+    auto updated_naive_cc = new NaiveCorrelationClustering(g);
+    auto updated_naive_output = updated_naive_cc->query(eps);
+    ASSERT_EQ(*updated_naive_output, *updated);
+    delete updated_naive_output;
+    delete updated_naive_cc;
+    delete updated;
+    delete naive_output;
+    delete naive_cc;
+    delete after;
+    delete old_to_new;
+    delete before;
+}
 
 int main(int argc, char**argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include "../lib/Intersection.h"
+
+std::vector<vertex_id_t> random_sorted_set(unsigned long size, unsigned long universe, std::mt19937_64 &rng) {
+    std::set<vertex_id_t> s;
+    std::uniform_int_distribution<unsigned long> dist(0ul, universe - 1);
+    while (s.size() < size)
+        s.insert(dist(rng));
+    return std::vector<vertex_id_t>(s.begin(), s.end());
+}
+
+unsigned long reference_count(const std::vector<vertex_id_t> &a, const std::vector<vertex_id_t> &b) {
+    std::vector<vertex_id_t> out;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out.size();
+}
+
+TEST(Intersection, AllKernelsAgreeWithSetIntersection) {
+    std::mt19937_64 rng(42);
+    unsigned long sizes[] = {0ul, 1ul, 3ul, 4ul, 7ul, 16ul, 33ul, 100ul, 1000ul};
+    for(auto size_a: sizes) {
+        for(auto size_b: sizes) {
+            for(unsigned long universe: {2000ul, 5000ul}) {
+                auto a = random_sorted_set(size_a, universe, rng);
+                auto b = random_sorted_set(size_b, universe, rng);
+                auto expected = reference_count(a, b);
+                ASSERT_EQ(expected, intersection_count(a.data(), a.size(), b.data(), b.size()));
+                ASSERT_EQ(expected, intersection_count_scalar(a.data(), a.size(), b.data(), b.size()));
+                ASSERT_EQ(expected, intersection_count_galloping(a.data(), a.size(), b.data(), b.size()));
+                ASSERT_EQ(expected, intersection_count_sse(a.data(), a.size(), b.data(), b.size()));
+                ASSERT_EQ(expected, intersection_count_avx2(a.data(), a.size(), b.data(), b.size()));
+            }
+        }
+    }
+}
+
+TEST(Intersection, IdenticalAndDisjointLists) {
+    std::vector<vertex_id_t> a, b;
+    for(unsigned long i = 0ul; i < 257ul; ++i) {
+        a.push_back(2 * i);
+        b.push_back(2 * i + 1);
+    }
+    ASSERT_EQ(a.size(), intersection_count(a.data(), a.size(), a.data(), a.size()));
+    ASSERT_EQ(0ul, intersection_count(a.data(), a.size(), b.data(), b.size()));
+    ASSERT_EQ(0ul, intersection_count_galloping(a.data(), 3ul, b.data(), b.size()));
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
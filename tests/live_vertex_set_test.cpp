@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "../lib/LiveVertexSet.h"
+#include "../lib/Graph.h"
+
+static std::vector<unsigned long> elements(const LiveVertexSet &live) {
+    std::vector<unsigned long> result;
+    live.for_each([&result](unsigned long v) { result.push_back(v); });
+    return result;
+}
+
+TEST(LiveVertexSetTest, MatchesSet) {
+    std::mt19937 rng(11u);
+    for(unsigned long id_bound: {0ul, 1ul, 63ul, 64ul, 65ul, 1000ul}) {
+        LiveVertexSet live(id_bound);
+        std::set<unsigned long> expected;
+        for(unsigned long v = 0ul; v < id_bound; ++v)
+            expected.insert(v);
+        for(unsigned long step = 0ul; step < 3000ul; ++step) {
+            if (rng() % 3 == 0u)
+                expected.insert(live.add());
+            else {
+                auto v = rng() % (live.get_id_bound() + 1ul);
+                live.remove(v);
+                expected.erase(v);
+            }
+            ASSERT_EQ(expected.size(), live.size());
+        }
+        ASSERT_EQ(std::vector<unsigned long>(expected.begin(), expected.end()), elements(live));
+        for(unsigned long v = 0ul; v < live.get_id_bound() + 64ul; ++v)
+            ASSERT_EQ(expected.count(v) == 1ul, live.contains(v));
+        auto old_to_new = live.compaction_map();
+        ASSERT_EQ(live.get_id_bound(), old_to_new->size());
+        unsigned long next = 0ul;
+        for(unsigned long v = 0ul; v < old_to_new->size(); ++v)
+            ASSERT_EQ(expected.count(v) ? next++ : REMOVED_VERTEX_ID, (*old_to_new)[v]);
+        delete old_to_new;
+        LiveVertexSet copy(&live);
+        ASSERT_EQ(elements(live), elements(copy));
+    }
+}
+
+TEST(LiveVertexSetTest, GraphCompactionKeepsTheEdges) {
+    // a path 0 - 1 - ... - 199 with every third vertex removed
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    for(unsigned long v = 0ul; v + 1 < 200ul; ++v)
+        edges.push_back(std::make_pair(v, v + 1));
+    Graph g;
+    g.load_from_edges(200ul, &edges);
+    for(unsigned long v = 0ul; v < 200ul; v += 3)
+        g.remove_vertex(v);
+    ASSERT_EQ(133ul, g.get_live_vertices()->size());
+    ASSERT_EQ(200ul, g.get_id_bound());
+    auto m = g.get_positive_m();
+    auto old_to_new = g.compact_ids();
+    ASSERT_EQ(133ul, g.get_n());
+    ASSERT_EQ(133ul, g.get_id_bound());
+    ASSERT_EQ(133ul, g.get_live_vertices()->get_id_bound());
+    ASSERT_EQ(m, g.get_positive_m());
+    for(unsigned long v = 0ul; v < 200ul; ++v) {
+        if (v % 3 == 0ul) {
+            ASSERT_EQ(REMOVED_VERTEX_ID, (*old_to_new)[v]);
+            continue;
+        }
+        auto neigh = g.get_neighborhood((*old_to_new)[v]);
+        ASSERT_TRUE(std::is_sorted(neigh->begin(), neigh->end()));
+        // the surviving neighbor of v is v - 1 or v + 1
+        auto other = (v % 3 == 1ul) ? v + 1 : v - 1;
+        if (other < 200ul) {
+            ASSERT_EQ(1ul, neigh->size());
+            ASSERT_EQ((*old_to_new)[other], (*neigh)[0]);
+        }
+        else
+            ASSERT_TRUE(neigh->empty());
+    }
+    delete old_to_new;
+    ASSERT_EQ(133ul, g.add_vertex());
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
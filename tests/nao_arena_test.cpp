@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include "../lib/NAO.h"
+#include "../lib/NAOArena.h"
+#include "TestGraphs.h"
+
+class NAOArenaTest : public ::testing::Test {
+    protected:
+        Graph *g;
+        GraphCSR *csr;
+        NAOArena *arena;
+
+        void SetUp() override {
+            this->g = new Graph();
+            load_test_graph(this->g);
+            this->csr = new GraphCSR(this->g);
+            this->arena = new NAOArena(this->csr, 4u);
+        }
+
+        void TearDown() override {
+            delete this->arena;
+            delete this->csr;
+            delete this->g;
+        }
+
+        void expect_same_as_nao(unsigned long v, NAO *nao) {
+            auto expected = nao->get_nao();
+            auto actual = this->arena->entries(v);
+            ASSERT_EQ(expected->size(), this->arena->size(v));
+            for(unsigned long i = 0ul; i < expected->size(); ++i) {
+                ASSERT_DOUBLE_EQ((*expected)[i].second, actual[i].second);
+                ASSERT_DOUBLE_EQ((*expected)[i].second,
+                    na_key_to_double(this->arena->query_key(v, (*expected)[i].first)));
+            }
+        }
+
+        void expect_heavy_as_is_heavy(const std::vector<double> &eps_values) {
+            std::vector<unsigned char> heavy;
+            for(auto eps: eps_values) {
+                this->arena->classify_heavy(eps, &heavy);
+                ASSERT_EQ(this->arena->get_n(), heavy.size());
+                auto threshold = to_nao_threshold(eps_to_key(eps));
+                for(unsigned long v = 0ul; v < heavy.size(); ++v)
+                    ASSERT_EQ(this->arena->is_heavy(v, eps, threshold), heavy[v] != 0) << "v = " << v << ", eps = " << eps;
+            }
+        }
+
+        std::vector<double> eps_around_intervals(const std::vector<unsigned long> &vertices) {
+            std::vector<double> eps_values = {0.0, 0.1, 0.25, 0.5, 0.75, 1.0, 1.5};
+            for(auto v: vertices) {
+                for(auto &interval: this->arena->heavy_intervals(v)) {
+                    for(auto e: {interval.first, interval.second}) {
+                        eps_values.push_back(e);
+                        eps_values.push_back(std::nextafter(e, 0.0));
+                        eps_values.push_back(std::nextafter(e, 2.0));
+                    }
+                }
+            }
+            return eps_values;
+        }
+};
+
+TEST_F(NAOArenaTest, MatchesNAOs) {
+    ASSERT_EQ(this->g->get_n(), this->arena->get_n());
+    for(unsigned long v = 0ul; v < this->g->get_n(); ++v) {
+        auto nao = new NAO(v, this->g);
+        this->expect_same_as_nao(v, nao);
+        for(double eps: {0.1, 0.3, 0.5, 0.8, 0.95})
+            ASSERT_EQ(nao->is_heavy(eps), this->arena->is_heavy(v, eps, to_nao_threshold(eps_to_key(eps))));
+        for(auto &e: *(nao->get_nao()))
+            ASSERT_EQ(this->g->non_agreement_key(v, e.first), this->arena->query_key(v, e.first));
+        delete nao;
+    }
+}
+
+TEST_F(NAOArenaTest, UpdatesMatchNAO) {
+    const unsigned long VERTEX = 0ul;
+    auto nao = new NAO(VERTEX, this->g);
+    auto entries = *(nao->get_nao());
+    // moving every other entry to a new non-agreement, in place
+    std::vector<std::pair<unsigned long, double>> changes;
+    std::vector<std::pair<unsigned long, na_key_t>> key_changes;
+    for(unsigned long i = 0ul; i < entries.size(); i += 2) {
+        auto key = na_key(i % 5, 4ul);
+        changes.push_back(std::make_pair(entries[i].first, na_key_to_double(key)));
+        key_changes.push_back(std::make_pair(entries[i].first, key));
+    }
+    nao->add_update_positive_edges(changes);
+    this->arena->update_existing(VERTEX, key_changes);
+    this->expect_same_as_nao(VERTEX, nao);
+    // inserting far more new neighbors than the slack, which moves the range
+    auto first_new = this->g->get_n();
+    for(unsigned long i = 0ul; i < 3 * entries.size() + 8; ++i) {
+        auto key = na_key(i % 7, 7ul);
+        nao->add_update_positive_edge(first_new + i, na_key_to_double(key));
+        this->arena->insert(VERTEX, first_new + i, key);
+    }
+    this->expect_same_as_nao(VERTEX, nao);
+    for(unsigned long i = 0ul; i < entries.size(); i += 3) {
+        nao->remove_positive_edge(entries[i].first);
+        this->arena->remove(VERTEX, entries[i].first);
+    }
+    this->expect_same_as_nao(VERTEX, nao);
+    ASSERT_EQ(NA_KEY_INVALID, this->arena->query_key(VERTEX, entries[0].first));
+    delete nao;
+}
+
+TEST_F(NAOArenaTest, RemovingVerticesCompacts) {
+    auto n = this->arena->get_n();
+    auto before = this->arena->memory_bytes();
+    for(unsigned long v = 1ul; v < n; ++v)
+        this->arena->remove_vertex(v);
+    ASSERT_TRUE(this->arena->has(0ul));
+    ASSERT_FALSE(this->arena->has(1ul));
+    ASSERT_LT(this->arena->memory_bytes(), before);
+    auto nao = new NAO(0ul, this->g);
+    this->expect_same_as_nao(0ul, nao);
+    delete nao;
+    auto v = this->arena->add_vertex();
+    ASSERT_EQ(n, v);
+    ASSERT_EQ(0ul, this->arena->size(v));
+    this->arena->assign(v, {{0ul, na_key(1ul, 2ul)}, {1ul, na_key(1ul, 4ul)}, {2ul, na_key(3ul, 4ul)}});
+    ASSERT_EQ(1ul, this->arena->ids_of(v)[0]);
+    ASSERT_EQ(na_key(6ul, 8ul), this->arena->query_key(v, 2ul));
+}
+
+TEST_F(NAOArenaTest, HeavyIntervalsMatchIsHeavy) {
+    std::vector<unsigned long> sample;
+    for(unsigned long v = 0ul; v < this->arena->get_n(); v += 7ul)
+        sample.push_back(v);
+    this->expect_heavy_as_is_heavy(this->eps_around_intervals(sample));
+    // the intervals follow the updates of a NAO
+    const unsigned long VERTEX = 0ul;
+    auto ids = this->arena->ids_of(VERTEX);
+    std::vector<unsigned long> neighbors(ids, ids + this->arena->size(VERTEX));
+    std::vector<std::pair<unsigned long, na_key_t>> key_changes;
+    for(unsigned long i = 0ul; i < neighbors.size(); i += 2)
+        key_changes.push_back(std::make_pair(neighbors[i], na_key(i % 3, 3ul)));
+    this->arena->update_existing(VERTEX, key_changes);
+    auto stranger = this->arena->get_n() - 1;
+    while (std::find(neighbors.begin(), neighbors.end(), stranger) != neighbors.end())
+        stranger--;
+    this->arena->insert(VERTEX, stranger, na_key(1ul, 5ul));
+    this->arena->remove(VERTEX, neighbors.back());
+    // stale until refreshed, and right in both cases
+    this->expect_heavy_as_is_heavy({0.2, 0.5});
+    this->arena->refresh_heavy_intervals(4u);
+    this->expect_heavy_as_is_heavy(this->eps_around_intervals({VERTEX}));
+    this->arena->remove_vertex(VERTEX);
+    ASSERT_TRUE(this->arena->heavy_intervals(VERTEX).empty());
+    this->expect_heavy_as_is_heavy({0.2, 0.5});
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -140,6 +140,24 @@ TEST_F(SimpleGraphTest, NAOsEqualLightness) {
     }
 }
 
+TEST_F(SimpleGraphTest, ParallelConstructionEqualsSequential) {
+    auto csr = new GraphCSR(this->g);
+    auto parallel_naos = construct_naos(csr, 4u);
+    ASSERT_EQ(this->g->get_n(), parallel_naos->size());
+    for(unsigned long i = 0ul; i < this->g->get_n(); ++i) {
+        auto expected = this->naos->at(i)->get_nao();
+        auto actual = (*parallel_naos)[i]->get_nao();
+        ASSERT_EQ(expected->size(), actual->size());
+        for(unsigned long j = 0ul; j < expected->size(); ++j) {
+            ASSERT_EQ((*expected)[j].first, (*actual)[j].first);
+            ASSERT_DOUBLE_EQ((*expected)[j].second, (*actual)[j].second);
+        }
+    }
+    for(auto nao: *parallel_naos)
+        delete nao;
+    delete parallel_naos;
+    delete csr;
+}
 
 int main(int argc, char**argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../lib/NonAgreement.h"
+
+TEST(NonAgreementTest, KeysOrderFractionsExactly) {
+    // all the fractions num/den in [0, 2) with small denominators
+    std::vector<std::pair<unsigned long, unsigned long>> fractions;
+    for(unsigned long den = 1ul; den <= 60ul; ++den)
+        for(unsigned long num = 0ul; num < 2 * den; ++num)
+            fractions.push_back(std::make_pair(num, den));
+    for(auto &a: fractions) {
+        auto key_a = na_key(a.first, a.second);
+        ASSERT_EQ(static_cast<double>(a.first) / a.second, na_key_to_double(key_a));
+        ASSERT_LT(key_a, NA_KEY_ALL);
+        for(auto &b: fractions) {
+            auto key_b = na_key(b.first, b.second);
+            // comparing the fractions by cross multiplication
+            ASSERT_EQ(a.first * b.second < b.first * a.second, key_a < key_b);
+            ASSERT_EQ(a.first * b.second == b.first * a.second, key_a == key_b);
+        }
+    }
+    ASSERT_EQ(na_key(1ul, 2ul), non_agreement_key(3ul, 3ul, 2ul));
+    ASSERT_EQ(na_key(5ul, 4ul), non_agreement_key(3ul, 2ul, 0ul));
+}
+
+TEST(NonAgreementTest, ThresholdsMatchDoubleComparisons) {
+    std::mt19937 rng(11u);
+    std::uniform_int_distribution<unsigned long> random_den(1ul, 100000ul);
+    std::uniform_real_distribution<double> random_eps(0.002, 1.999);
+    for(unsigned long step = 0ul; step < 200000ul; ++step) {
+        auto den = random_den(rng);
+        auto num = std::uniform_int_distribution<unsigned long>(0ul, 2 * den - 1)(rng);
+        double na = static_cast<double>(num) / den;
+        // the eps right at, right above and away from the non-agreement,
+        // in the range where the thresholds are exact
+        for(double eps: {na, std::nextafter(na, 2.0), random_eps(rng)}) {
+            if (eps > std::ldexp(1.0, -9)) {
+                ASSERT_EQ(na < eps, na_key(num, den) < eps_to_key(eps));
+            }
+        }
+    }
+    ASSERT_EQ(0ul, eps_to_key(0.0));
+    ASSERT_EQ(0ul, eps_to_key(-1.0));
+    ASSERT_EQ(NA_KEY_ALL, eps_to_key(2.0));
+    ASSERT_LT(na_key(0ul, 7ul), eps_to_key(1e-300));
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
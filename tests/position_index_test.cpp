@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include "../lib/PositionIndex.h"
+
+TEST(PositionIndexTest, MatchesHashMap) {
+    std::mt19937 rng(7u);
+    std::uniform_int_distribution<std::uint32_t> random_id(0u, 500u);
+    PositionIndex<std::uint32_t> index;
+    std::unordered_map<std::uint32_t, std::uint32_t> expected;
+    for(std::uint32_t step = 0u; step < 20000u; ++step) {
+        auto id = random_id(rng);
+        if (step % 3 == 0u) {
+            index.erase(id);
+            expected.erase(id);
+        }
+        else {
+            index.set(id, step);
+            expected[id] = step;
+        }
+        ASSERT_EQ(expected.size(), index.size());
+    }
+    for(std::uint32_t id = 0u; id <= 500u; ++id) {
+        auto it = expected.find(id);
+        if (it == expected.end())
+            ASSERT_EQ(PositionIndex<std::uint32_t>::NOT_FOUND, index.find(id));
+        else
+            ASSERT_EQ(it->second, index.find(id));
+    }
+}
+
+TEST(PositionIndexTest, EraseKeepsClustersReachable) {
+    // ids which are multiples of a large power of 2 tend to share home buckets
+    PositionIndex<unsigned long> index(4ul);
+    for(unsigned long i = 0ul; i < 64ul; ++i)
+        index.set(i << 40, i);
+    for(unsigned long i = 0ul; i < 64ul; i += 2)
+        index.erase(i << 40);
+    for(unsigned long i = 0ul; i < 64ul; ++i)
+        ASSERT_EQ((i % 2) ? i : PositionIndex<unsigned long>::NOT_FOUND, index.find(i << 40));
+    index.clear();
+    ASSERT_EQ(0ul, index.size());
+    ASSERT_EQ(PositionIndex<unsigned long>::NOT_FOUND, index.find(1ul << 40));
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
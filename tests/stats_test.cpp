@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../lib/Stats.h"
+#include "../lib/Parallel.h"
+#include "../lib/Graph.h"
+#include "../lib/NaiveCorrelationClustering.h"
+#include "../lib/IndexBasedCorrelationClustering.h"
+
+TEST(Stats, AddsTheCountsOfAllThreads) {
+    stats_reset();
+    parallel_for(0ul, 1000ul, [](unsigned long i) {
+        stat_add(STAT_INTERSECTIONS, i);
+        PhaseTimer timer(PHASE_LABELS);
+    }, 4u);
+    stat_add(STAT_UNIONS, 3ul);
+    auto stats = stats_snapshot();
+    ASSERT_EQ(stats.counters[STAT_INTERSECTIONS], 999ul * 1000ul / 2);
+    ASSERT_EQ(stats.counters[STAT_UNIONS], 3ul);
+    ASSERT_EQ(stats.phase_calls[PHASE_LABELS], 1000ul);
+    ASSERT_EQ(stats.phase_calls[PHASE_LOAD], 0ul);
+    // a snapshot does not count twice
+    ASSERT_EQ(stats_snapshot().counters[STAT_INTERSECTIONS], 999ul * 1000ul / 2);
+    stats_reset();
+    ASSERT_EQ(stats_snapshot().counters[STAT_INTERSECTIONS], 0ul);
+    ASSERT_EQ(stats_snapshot().phase_calls[PHASE_LABELS], 0ul);
+}
+
+TEST(Stats, WritesJson) {
+    stats_reset();
+    stat_add(STAT_EDGES_PRUNED, 42ul);
+    {
+        PhaseTimer timer(PHASE_INDEX_QUERY);
+    }
+    std::stringstream out;
+    write_stats_json(out, "test");
+    auto json = out.str();
+    ASSERT_NE(json.find("\"run\": \"test\""), std::string::npos);
+    ASSERT_NE(json.find("\"edges_pruned\": 42"), std::string::npos);
+    ASSERT_NE(json.find("\"index_query\": {\"calls\": 1, \"ms\": "), std::string::npos);
+    ASSERT_EQ(json.find("\"load\""), std::string::npos);
+    stats_reset();
+}
+
+TEST(Stats, EnginesCountTheSameWork) {
+    const unsigned long N = 400ul;
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    unsigned long x = 11ul;
+    for(unsigned long i = 0ul; i < 3000ul; ++i) {
+        x = x * 6364136223846793005ul + 1442695040888963407ul;
+        auto u = (x >> 33) % N;
+        auto v = (i % 3 == 0) ? (x >> 20) % N : (u / 8) * 8 + (x >> 45) % 8;
+        if (u != v)
+            edges.push_back(std::make_pair(u, v));
+    }
+    Graph g;
+    g.load_from_edges(N, &edges);
+    NaiveCorrelationClustering naive(&g);
+    IndexBasedCorrelationClustering index(&g, 2u);
+    unsigned long scanned = 0ul;
+    for(double eps: {0.2, 0.5, 0.8}) {
+        stats_reset();
+        delete naive.query(eps);
+        auto naive_stats = stats_snapshot();
+        stats_reset();
+        delete index.query(eps);
+        auto index_stats = stats_snapshot();
+        ASSERT_EQ(naive_stats.counters[STAT_EDGES_PRUNED], index_stats.counters[STAT_EDGES_PRUNED]);
+        ASSERT_EQ(naive_stats.counters[STAT_LIGHT_VERTICES], index_stats.counters[STAT_LIGHT_VERTICES]);
+        ASSERT_EQ(naive_stats.counters[STAT_UNIONS], index_stats.counters[STAT_UNIONS]);
+        scanned += index_stats.counters[STAT_NAO_ENTRIES_SCANNED];
+        ASSERT_EQ(naive_stats.phase_calls[PHASE_NAIVE_QUERY], 1ul);
+        ASSERT_EQ(index_stats.phase_calls[PHASE_INDEX_QUERY], 1ul);
+    }
+    ASSERT_GT(scanned, 0ul);
+    stats_reset();
+    index.add_edge(0ul, N - 1);
+    index.remove_edge(0ul, N - 1);
+    ASSERT_EQ(stats_snapshot().counters[STAT_UPDATES_APPLIED], 2ul);
+    ASSERT_EQ(stats_snapshot().phase_calls[PHASE_UPDATE], 2ul);
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <fstream>
+#include <stdexcept>
+#include "../lib/SyntheticGraph.h"
+#include "../lib/Graph.h"
+
+/**
+ * @brief all the edges of the synthetic graph, in the order of its blocks
+ */
+static std::vector<std::pair<unsigned long, unsigned long>> all_edges(const SyntheticGraph &graph,
+    unsigned int num_threads)
+{
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    graph.for_each_block([&edges](unsigned long, const std::vector<std::pair<unsigned long, unsigned long>> &block) {
+        edges.insert(edges.end(), block.begin(), block.end());
+    }, num_threads);
+    return edges;
+}
+
+TEST(SyntheticGraph, SameEdgesForAnyNumberOfThreads) {
+    SyntheticGraphParams planted;
+    planted.model = PLANTED_PARTITION;
+    planted.n = 20000ul;
+    planted.clusters = 200ul;
+    planted.p_in = 0.3;
+    planted.p_out = 0.0005;
+    planted.seed = 7ul;
+    SyntheticGraphParams rmat;
+    rmat.model = RMAT;
+    rmat.n = 5000ul;
+    rmat.m = 200000ul;
+    for(auto params: {planted, rmat}) {
+        SyntheticGraph one(params, 1u), four(params, 4u);
+        ASSERT_EQ(one.get_m(), four.get_m());
+        ASSERT_GT(one.get_num_blocks(), 1ul);
+        auto edges = all_edges(one, 1u);
+        ASSERT_EQ(edges.size(), one.get_m());
+        ASSERT_EQ(edges, all_edges(four, 4u));
+        for(auto &e: edges) {
+            ASSERT_LT(e.first, e.second);
+            ASSERT_LT(e.second, params.n);
+        }
+    }
+}
+
+TEST(SyntheticGraph, PlantedPartitionHasItsClusters) {
+    SyntheticGraphParams params;
+    params.model = PLANTED_PARTITION;
+    params.n = 1000ul;
+    params.clusters = 30ul;
+    params.p_in = 1.0;
+    params.p_out = 0.0;
+    SyntheticGraph cliques(params, 2u);
+    // without noise, every cluster is a clique and there is no other edge
+    unsigned long pairs = 0ul;
+    std::vector<unsigned long> sizes(params.clusters + 1, 0ul);
+    for(unsigned long v = 0ul; v < params.n; ++v)
+        sizes[cliques.cluster_of(v)]++;
+    for(unsigned long c = 1ul; c <= params.clusters; ++c) {
+        ASSERT_GE(sizes[c], params.n / params.clusters);
+        pairs += sizes[c] * (sizes[c] - 1) / 2;
+    }
+    ASSERT_EQ(cliques.get_m(), pairs);
+    for(auto &e: all_edges(cliques, 2u))
+        ASSERT_EQ(cliques.cluster_of(e.first), cliques.cluster_of(e.second));
+    // with noise, the counts are near their expectations
+    params.n = 20000ul;
+    params.clusters = 100ul;
+    params.p_in = 0.2;
+    params.p_out = 0.001;
+    SyntheticGraph noisy(params, 2u);
+    double intra = 0.0, inter = 0.0;
+    for(auto &e: all_edges(noisy, 2u))
+        (noisy.cluster_of(e.first) == noisy.cluster_of(e.second) ? intra : inter) += 1.0;
+    double expected_intra = 0.2 * 100 * (200.0 * 199.0 / 2);
+    double expected_inter = 0.001 * (20000.0 * 19999.0 / 2 - 100 * (200.0 * 199.0 / 2));
+    ASSERT_NEAR(intra / expected_intra, 1.0, 0.02);
+    ASSERT_NEAR(inter / expected_inter, 1.0, 0.02);
+}
+
+TEST(SyntheticGraph, WritesALoadableEdgeList) {
+    SyntheticGraphParams params;
+    params.model = ERDOS_RENYI;
+    params.n = 3000ul;
+    params.p_in = 0.01;
+    SyntheticGraph graph(params, 2u);
+    std::string filename = "synthetic_graph_test.txt";
+    write_synthetic_edge_list(&graph, filename, 2u);
+    Graph loaded;
+    loaded.load_from_file(filename, 2u);
+    std::remove(filename.c_str());
+    auto built = build_synthetic_graph(&graph, 2u);
+    ASSERT_EQ(loaded.get_n(), params.n);
+    ASSERT_EQ(loaded.get_positive_m(), graph.get_m());
+    ASSERT_EQ(built->get_positive_m(), graph.get_m());
+    for(auto &e: all_edges(graph, 1u))
+        ASSERT_TRUE(loaded.is_in_neigh_plus(e.first, e.second));
+    delete built;
+}
+
+TEST(SyntheticGraph, UpdateStreamMatchesTheGraph) {
+    SyntheticGraphParams params;
+    params.model = PLANTED_PARTITION;
+    params.n = 5000ul;
+    params.clusters = 50ul;
+    params.p_in = 0.3;
+    params.p_out = 0.0002;
+    SyntheticGraph graph(params, 2u);
+    auto edges = all_edges(graph, 2u);
+    std::set<std::pair<unsigned long, unsigned long>> edge_set(edges.begin(), edges.end());
+    auto updates = synthetic_update_stream(&graph, 1001ul, 100ul, 0.4, 2u);
+    unsigned long adds = 0ul, removes = 0ul, queries = 0ul;
+    for(auto &update: *updates) {
+        if (update.type == QUERY) {
+            ASSERT_EQ(update.eps, 0.4);
+            ++queries;
+            continue;
+        }
+        ASSERT_LT(update.u, update.v);
+        ASSERT_LT(update.v, params.n);
+        if (update.type == REMOVE_EDGE) {
+            ASSERT_TRUE(edge_set.count(std::make_pair(update.u, update.v)));
+            ++removes;
+        }
+        else {
+            ASSERT_EQ(update.type, ADD_EDGE);
+            ++adds;
+        }
+    }
+    ASSERT_EQ(removes, 500ul);
+    ASSERT_EQ(adds, 501ul);
+    ASSERT_EQ(queries, 10ul);
+    auto again = synthetic_update_stream(&graph, 1001ul, 100ul, 0.4, 1u);
+    for(unsigned long i = 0ul; i < updates->size(); ++i) {
+        ASSERT_EQ((*updates)[i].type, (*again)[i].type);
+        ASSERT_EQ((*updates)[i].u, (*again)[i].u);
+        ASSERT_EQ((*updates)[i].v, (*again)[i].v);
+    }
+    delete again;
+    delete updates;
+}
+
+TEST(SyntheticGraph, RejectsBadParameters) {
+    SyntheticGraphParams params;
+    params.model = PLANTED_PARTITION;
+    params.n = 10ul;
+    params.clusters = 11ul;
+    ASSERT_THROW(SyntheticGraph graph(params), std::invalid_argument);
+    params.clusters = 2ul;
+    params.p_in = 1.5;
+    ASSERT_THROW(SyntheticGraph graph(params), std::invalid_argument);
+    params.model = RMAT;
+    params.b = params.c = 0.0;
+    ASSERT_THROW(SyntheticGraph graph(params), std::invalid_argument);
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../lib/UnionFind.h"
+#include "../lib/Parallel.h"
+#include "../lib/VertexId.h"
+
+TEST(UnionFind, LabelsFollowTheSmallestVertex) {
+    UnionFind uf(6ul);
+    ASSERT_TRUE(uf.unite(4ul, 1ul));
+    ASSERT_TRUE(uf.unite(5ul, 3ul));
+    ASSERT_TRUE(uf.unite(3ul, 1ul));
+    ASSERT_FALSE(uf.unite(5ul, 4ul));
+    ASSERT_EQ(uf.find(5ul), uf.find(1ul));
+    auto labels = uf.labels();
+    std::vector<unsigned long> expected = {1ul, 2ul, 3ul, 2ul, 2ul, 2ul};
+    ASSERT_EQ(expected, *labels);
+    delete labels;
+}
+
+TEST(UnionFind, SingletonsAreNumberedInOrder) {
+    UnionFind uf(4ul);
+    auto labels = uf.labels();
+    std::vector<unsigned long> expected = {1ul, 2ul, 3ul, 4ul};
+    ASSERT_EQ(expected, *labels);
+    delete labels;
+}
+
+TEST(UnionFind, ConcurrentUnitesMatchSequential) {
+    const unsigned long N = 200000ul, M = 150000ul;
+    std::vector<std::pair<unsigned long, unsigned long>> edges;
+    unsigned long x = 12345ul;
+    for(unsigned long i = 0ul; i < M; ++i) {
+        x = x * 6364136223846793005ul + 1442695040888963407ul;
+        auto u = (x >> 33) % N;
+        x = x * 6364136223846793005ul + 1442695040888963407ul;
+        edges.push_back(std::make_pair(u, (x >> 33) % N));
+    }
+    UnionFind sequential(N);
+    for(auto &e: edges)
+        sequential.unite(e.first, e.second);
+    auto expected = sequential.labels();
+    UnionFind concurrent(N, 8u);
+    parallel_for(0ul, M, [&](unsigned long i) {
+        concurrent.unite(edges[i].first, edges[i].second);
+    }, 8u);
+    auto labels = concurrent.labels(8u);
+    ASSERT_EQ(*expected, *labels);
+    for(auto &e: edges)
+        ASSERT_EQ(concurrent.find(e.first), concurrent.find(e.second));
+    delete labels;
+    delete expected;
+}
+
+TEST(UnionFind, RejectsMoreVerticesThanTheIdWidth) {
+    ASSERT_NO_THROW(check_vertex_id_bound(VERTEX_ID_BOUND));
+#ifdef VERTEX_32BIT_IDS
+    ASSERT_THROW(check_vertex_id_bound(VERTEX_ID_BOUND + 1ul), std::overflow_error);
+    ASSERT_THROW(UnionFind(VERTEX_ID_BOUND + 1ul), std::overflow_error);
+#endif
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
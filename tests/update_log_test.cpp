@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include "../lib/UpdateLog.h"
+
+std::string write_temp_file(std::string name, std::string content) {
+    auto filename = ::testing::TempDir() + name;
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << content;
+    return filename;
+}
+
+TEST(UpdateLog, ReadsAllOperations) {
+    auto filename = write_temp_file("update_log_test.log",
+        "# a comment\nadd_edge 1 2\n\nremove_edge 3 4\nadd_vertex\nremove_vertex 5\nquery 0.25\n");
+    auto updates = read_update_log(filename);
+    ASSERT_EQ(5lu, updates->size());
+    ASSERT_EQ(ADD_EDGE, (*updates)[0].type);
+    ASSERT_EQ(1lu, (*updates)[0].u);
+    ASSERT_EQ(2lu, (*updates)[0].v);
+    ASSERT_EQ(REMOVE_EDGE, (*updates)[1].type);
+    ASSERT_EQ(ADD_VERTEX, (*updates)[2].type);
+    ASSERT_EQ(REMOVE_VERTEX, (*updates)[3].type);
+    ASSERT_EQ(5lu, (*updates)[3].u);
+    ASSERT_EQ(QUERY, (*updates)[4].type);
+    ASSERT_DOUBLE_EQ(0.25, (*updates)[4].eps);
+    // writing them back gives the same log without the comments
+    std::ostringstream out;
+    for(auto &update: *updates)
+        write_update(out, update);
+    ASSERT_EQ("add_edge 1 2\nremove_edge 3 4\nadd_vertex\nremove_vertex 5\nquery 0.25\n", out.str());
+    delete updates;
+    std::remove(filename.c_str());
+}
+
+TEST(UpdateLog, RejectsMalformedLines) {
+    for(auto content: {"add_edge 1\n", "remove_vertex\n", "query\n", "add_vertex 3\n", "flip 1 2\n"}) {
+        auto filename = write_temp_file("update_log_test_malformed.log", content);
+        ASSERT_THROW(read_update_log(filename), std::runtime_error) << content;
+        std::remove(filename.c_str());
+    }
+    ASSERT_THROW(read_update_log(::testing::TempDir() + "no_such_update_log.log"), std::invalid_argument);
+}
+
+int main(int argc, char**argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}